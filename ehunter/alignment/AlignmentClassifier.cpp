@@ -72,6 +72,17 @@ RepeatAlignmentClassifier::RepeatAlignmentClassifier(const graphtools::Graph& gr
 
     right_flank_node_ids_ = graph.successors(repeat_node_id_);
     right_flank_node_ids_.erase(repeat_node_id_);
+
+    node_roles_.assign(graph.numNodes(), 0);
+    for (auto node_id : left_flank_node_ids_)
+    {
+        node_roles_[node_id] |= kLeftFlankNode;
+    }
+    for (auto node_id : right_flank_node_ids_)
+    {
+        node_roles_[node_id] |= kRightFlankNode;
+    }
+    node_roles_[repeat_node_id_] |= kRepeatNode;
 }
 
 GraphAlignment RepeatAlignmentClassifier::GetCanonicalAlignment(const list<GraphAlignment>& Alignments) const
@@ -99,22 +110,15 @@ GraphAlignment RepeatAlignmentClassifier::GetCanonicalAlignment(const list<Graph
 
 AlignmentType RepeatAlignmentClassifier::Classify(const GraphAlignment& alignment) const
 {
-    bool overlaps_left_flank = false;
-    bool overlaps_right_flank = false;
-
+    uint8_t roles_overlapped = 0;
     for (auto node_id : alignment.path().nodeIds())
     {
-        if (left_flank_node_ids_.find(node_id) != left_flank_node_ids_.end())
-        {
-            overlaps_left_flank = true;
-        }
-
-        if (right_flank_node_ids_.find(node_id) != right_flank_node_ids_.end())
-        {
-            overlaps_right_flank = true;
-        }
+        roles_overlapped |= node_roles_[node_id];
     }
 
+    const bool overlaps_left_flank = roles_overlapped & kLeftFlankNode;
+    const bool overlaps_right_flank = roles_overlapped & kRightFlankNode;
+    const bool overlaps_repeat = roles_overlapped & kRepeatNode;
     const bool overlaps_both_flanks = overlaps_left_flank && overlaps_right_flank;
     const bool overlaps_either_flank = overlaps_left_flank || overlaps_right_flank;
 
@@ -123,7 +127,6 @@ AlignmentType RepeatAlignmentClassifier::Classify(const GraphAlignment& alignmen
         return AlignmentType::kSpansRepeat;
     }
 
-    const bool overlaps_repeat = alignment.overlapsNode(repeat_node_id_);
     if (overlaps_either_flank && overlaps_repeat)
     {
         return AlignmentType::kFlanksRepeat;
@@ -58,9 +58,18 @@ public:
     bool operator==(const RepeatAlignmentClassifier& other) const;
 
 private:
+    enum NodeRole : uint8_t
+    {
+        kLeftFlankNode = 1,
+        kRightFlankNode = 2,
+        kRepeatNode = 4
+    };
+
     int32_t repeat_node_id_;
     std::set<graphtools::NodeId> left_flank_node_ids_;
     std::set<graphtools::NodeId> right_flank_node_ids_;
+    // Combination of NodeRole flags for each graph node
+    std::vector<uint8_t> node_roles_;
 };
 
 }
@@ -32,8 +32,6 @@
 
 using graphtools::GraphAlignment;
 using graphtools::NodeId;
-using graphtools::Operation;
-using graphtools::OperationType;
 using graphtools::Path;
 using std::list;
 using std::string;
@@ -43,7 +41,7 @@ namespace ehunter
 {
 
 bool checkIfLocallyPlacedReadPair(
-    boost::optional<GraphAlignment> readAlignment, boost::optional<GraphAlignment> mateAlignment,
+    const boost::optional<GraphAlignment>& readAlignment, const boost::optional<GraphAlignment>& mateAlignment,
     int kMinNonRepeatAlignmentScore)
 {
     int nonRepeatAlignmentScore = 0;
@@ -61,61 +59,53 @@ bool checkIfLocallyPlacedReadPair(
     return nonRepeatAlignmentScore >= kMinNonRepeatAlignmentScore;
 }
 
-bool checkIfUpstreamAlignmentIsGood(NodeId nodeId, GraphAlignment alignment)
+bool checkIfUpstreamAlignmentIsGood(NodeId nodeId, const AlignmentScoreSummary& alignmentSummary)
 {
-    const list<int> repeatNodeIndexes = alignment.getIndexesOfNode(nodeId);
+    const int firstRepeatNodeIndex = alignmentSummary.getFirstIndexOfNode(nodeId);
 
-    if (repeatNodeIndexes.empty())
+    if (firstRepeatNodeIndex == -1)
     {
         return false;
     }
 
-    const int firstRepeatNodeIndex = repeatNodeIndexes.front();
     int score = 0;
-    LinearAlignmentParameters parameters;
     for (int nodeIndex = 0; nodeIndex != firstRepeatNodeIndex; ++nodeIndex)
     {
-        score += scoreAlignment(
-            alignment[nodeIndex], parameters.matchScore, parameters.mismatchScore, parameters.gapOpenScore);
+        score += alignmentSummary.getNodeScore(nodeIndex);
     }
 
+    LinearAlignmentParameters parameters;
     const int kScoreCutoff = parameters.matchScore * 8;
 
     return score >= kScoreCutoff;
 }
 
-bool checkIfDownstreamAlignmentIsGood(NodeId nodeId, GraphAlignment alignment)
+bool checkIfDownstreamAlignmentIsGood(NodeId nodeId, const AlignmentScoreSummary& alignmentSummary)
 {
-    const list<int> repeatNodeIndexes = alignment.getIndexesOfNode(nodeId);
+    const int lastRepeatNodeIndex = alignmentSummary.getLastIndexOfNode(nodeId);
 
-    if (repeatNodeIndexes.empty())
+    if (lastRepeatNodeIndex == -1)
     {
         return false;
     }
 
-    const int lastRepeatNodeIndex = repeatNodeIndexes.back();
     int score = 0;
-    LinearAlignmentParameters parameters;
-    for (int nodeIndex = lastRepeatNodeIndex + 1; nodeIndex != static_cast<int>(alignment.size()); ++nodeIndex)
+    for (int nodeIndex = lastRepeatNodeIndex + 1; nodeIndex != alignmentSummary.numNodes(); ++nodeIndex)
     {
-        score += scoreAlignment(
-            alignment[nodeIndex], parameters.matchScore, parameters.mismatchScore, parameters.gapOpenScore);
+        score += alignmentSummary.getNodeScore(nodeIndex);
     }
 
+    LinearAlignmentParameters parameters;
     const int kScoreCutoff = parameters.matchScore * 8;
 
     return score >= kScoreCutoff;
 }
 
-bool checkIfPassesAlignmentFilters(const GraphAlignment& alignment)
+bool checkIfPassesAlignmentFilters(const AlignmentScoreSummary& alignmentSummary)
 {
-    const Operation& firstOperation = alignment.alignments().front().operations().front();
-    const int frontSoftclipLen = firstOperation.type() == OperationType::kSoftclip ? firstOperation.queryLength() : 0;
-
-    const Operation& lastOperation = alignment.alignments().back().operations().back();
-    const int backSoftclipLen = lastOperation.type() == OperationType::kSoftclip ? lastOperation.queryLength() : 0;
-
-    const int clippedQueryLength = alignment.queryLength() - frontSoftclipLen - backSoftclipLen;
+    const GraphAlignment& alignment = alignmentSummary.alignment();
+    const int clippedQueryLength
+        = alignment.queryLength() - alignmentSummary.leftSoftclipLength() - alignmentSummary.rightSoftclipLength();
     const int referenceLength = alignment.referenceLength();
 
     const int percentQueryMatches = (100 * alignment.numMatches()) / clippedQueryLength;
@@ -0,0 +1,118 @@
+//
+// Expansion Hunter
+// Copyright 2016-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#include "alignment/AlignmentScoreSummary.hh"
+
+#include "graphcore/Graph.hh"
+
+using graphtools::Alignment;
+using graphtools::Graph;
+using graphtools::GraphAlignment;
+using graphtools::NodeId;
+using graphtools::Operation;
+using graphtools::OperationType;
+
+namespace ehunter
+{
+
+static void scoreAlignment(
+    const Alignment& alignment, const LinearAlignmentParameters& parameters, int& score, int& indelCount)
+{
+    score = 0;
+    indelCount = 0;
+
+    for (const Operation& operation : alignment)
+    {
+        switch (operation.type())
+        {
+        case OperationType::kMatch:
+            score += parameters.matchScore * static_cast<int>(operation.referenceLength());
+            break;
+        case OperationType::kMismatch:
+            score += parameters.mismatchScore * static_cast<int>(operation.referenceLength());
+            break;
+        case OperationType::kInsertionToRef:
+            score += parameters.gapOpenScore * static_cast<int>(operation.queryLength());
+            indelCount += operation.queryLength();
+            break;
+        case OperationType::kDeletionFromRef:
+            score += parameters.gapOpenScore * static_cast<int>(operation.referenceLength());
+            indelCount += operation.referenceLength();
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+AlignmentScoreSummary::AlignmentScoreSummary(
+    const GraphAlignment& alignment, const LinearAlignmentParameters& parameters)
+    : alignment_(&alignment)
+{
+    const Graph& graph = *alignment.path().graphRawPtr();
+    const int numNodes = static_cast<int>(alignment.size());
+    nodeScores_.resize(numNodes);
+    nodeIndelCounts_.resize(numNodes);
+    nodeOccurrences_.resize(graph.numNodes());
+
+    for (int nodeIndex = 0; nodeIndex != numNodes; ++nodeIndex)
+    {
+        const NodeId nodeId = alignment.getNodeIdByIndex(nodeIndex);
+        scoreAlignment(alignment[nodeIndex], parameters, nodeScores_[nodeIndex], nodeIndelCounts_[nodeIndex]);
+
+        if (!graph.hasEdge(nodeId, nodeId))
+        {
+            nonloopNodeScore_ += nodeScores_[nodeIndex];
+        }
+
+        NodeOccurrences& occurrences = nodeOccurrences_[nodeId];
+        if (occurrences.count == 0)
+        {
+            occurrences.firstIndex = nodeIndex;
+        }
+        occurrences.lastIndex = nodeIndex;
+        ++occurrences.count;
+    }
+
+    const Operation& firstOperation = alignment.alignments().front().operations().front();
+    leftSoftclipLength_ = firstOperation.type() == OperationType::kSoftclip ? firstOperation.queryLength() : 0;
+
+    const Operation& lastOperation = alignment.alignments().back().operations().back();
+    rightSoftclipLength_ = lastOperation.type() == OperationType::kSoftclip ? lastOperation.queryLength() : 0;
+}
+
+int AlignmentScoreSummary::getFirstIndexOfNode(NodeId nodeId) const
+{
+    return nodeId < nodeOccurrences_.size() ? nodeOccurrences_[nodeId].firstIndex : -1;
+}
+
+int AlignmentScoreSummary::getLastIndexOfNode(NodeId nodeId) const
+{
+    return nodeId < nodeOccurrences_.size() ? nodeOccurrences_[nodeId].lastIndex : -1;
+}
+
+int AlignmentScoreSummary::countOccurrencesOfNode(NodeId nodeId) const
+{
+    return nodeId < nodeOccurrences_.size() ? nodeOccurrences_[nodeId].count : 0;
+}
+
+}
@@ -0,0 +1,81 @@
+//
+// Expansion Hunter
+// Copyright 2016-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#pragma once
+
+#include <vector>
+
+#include "graphalign/GraphAlignment.hh"
+#include "graphalign/LinearAlignmentParameters.hh"
+
+namespace ehunter
+{
+
+/// Per-node scores and other quantities that alignment filters and genotyping derive from the operations of a graph
+/// alignment
+///
+/// The summary is computed once per alignment and refers to the alignment it was computed from, which must outlive
+/// it. Nodes are addressed by their index on the alignment path except where noted.
+class AlignmentScoreSummary
+{
+public:
+    explicit AlignmentScoreSummary(
+        const graphtools::GraphAlignment& alignment,
+        const LinearAlignmentParameters& parameters = LinearAlignmentParameters());
+
+    const graphtools::GraphAlignment& alignment() const { return *alignment_; }
+    int numNodes() const { return static_cast<int>(nodeScores_.size()); }
+    graphtools::NodeId getNodeIdByIndex(int nodeIndex) const { return alignment_->getNodeIdByIndex(nodeIndex); }
+
+    int getNodeScore(int nodeIndex) const { return nodeScores_[nodeIndex]; }
+    /// Number of inserted plus deleted bases
+    int getNodeIndelCount(int nodeIndex) const { return nodeIndelCounts_[nodeIndex]; }
+    /// Combined score of the alignments to nodes without self-loops
+    int nonloopNodeScore() const { return nonloopNodeScore_; }
+
+    int leftSoftclipLength() const { return leftSoftclipLength_; }
+    int rightSoftclipLength() const { return rightSoftclipLength_; }
+
+    /// Index of the first (last) occurrence of a graph node on the alignment path or -1 if the node does not occur
+    int getFirstIndexOfNode(graphtools::NodeId nodeId) const;
+    int getLastIndexOfNode(graphtools::NodeId nodeId) const;
+    int countOccurrencesOfNode(graphtools::NodeId nodeId) const;
+
+private:
+    struct NodeOccurrences
+    {
+        int firstIndex = -1;
+        int lastIndex = -1;
+        int count = 0;
+    };
+
+    const graphtools::GraphAlignment* alignment_;
+    std::vector<int> nodeScores_;
+    std::vector<int> nodeIndelCounts_;
+    int nonloopNodeScore_ = 0;
+    int leftSoftclipLength_ = 0;
+    int rightSoftclipLength_ = 0;
+    // Indexed by node id
+    std::vector<NodeOccurrences> nodeOccurrences_;
+};
+
+}
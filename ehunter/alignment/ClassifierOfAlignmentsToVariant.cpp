@@ -28,6 +28,8 @@
 
 #include <boost/algorithm/string/join.hpp>
 
+#include "alignment/VariantNodeRole.hh"
+
 using graphtools::NodeId;
 using std::string;
 using std::vector;
@@ -70,28 +72,24 @@ ClassifierOfAlignmentsToVariant::ClassifierOfAlignmentsToVariant(vector<NodeId>
 
 void ClassifierOfAlignmentsToVariant::classify(const graphtools::GraphAlignment& graphAlignment)
 {
-    bool pathStartsUpstream = false;
-    bool pathEndsDownstream = false;
-    bool pathOverlapsTargetNode = false;
+    // Bit for each role of the path nodes
+    unsigned rolesOverlapped = 0;
     NodeId targetNodeOverlapped = kInvalidNodeId;
 
     for (auto pathNode : graphAlignment.path().nodeIds())
     {
-        if (pathNode < firstBundleNode_)
-        {
-            pathStartsUpstream = true;
-        }
-        else if (lastBundleNode_ < pathNode)
+        const auto role = getVariantNodeRole(pathNode, firstBundleNode_, lastBundleNode_);
+        rolesOverlapped |= 1u << static_cast<unsigned>(role);
+        if (role == VariantNodeRole::kVariant)
         {
-            pathEndsDownstream = true;
-        }
-        else if (firstBundleNode_ <= pathNode && pathNode <= lastBundleNode_)
-        {
-            pathOverlapsTargetNode = true;
             targetNodeOverlapped = pathNode;
         }
     }
 
+    const bool pathStartsUpstream = rolesOverlapped & (1u << static_cast<unsigned>(VariantNodeRole::kUpstream));
+    const bool pathOverlapsTargetNode = rolesOverlapped & (1u << static_cast<unsigned>(VariantNodeRole::kVariant));
+    const bool pathEndsDownstream = rolesOverlapped & (1u << static_cast<unsigned>(VariantNodeRole::kDownstream));
+
     const bool spanningRead = pathStartsUpstream && pathEndsDownstream;
     const bool upstreamFlankingRead = pathStartsUpstream && pathOverlapsTargetNode;
     const bool downstreamFlankingRead = pathOverlapsTargetNode && pathEndsDownstream;
@@ -0,0 +1,95 @@
+//
+// Expansion Hunter
+// Copyright 2016-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "alignment/FlankKmerIndex.hh"
+
+#include <algorithm>
+
+#include "graphalign/KmerIndex.hh"
+
+using graphtools::Graph;
+using graphtools::KmerIndex;
+using graphtools::NodeId;
+using graphtools::Path;
+using graphtools::RollingTwoBitKmerEncoder;
+using std::string;
+
+namespace ehunter
+{
+
+static bool checkIfPathOverlapsNonloopNode(const Graph& graph, const Path& path)
+{
+    return std::any_of(path.begin(), path.end(), [&graph](NodeId nodeId) {
+        return graph.successors(nodeId).find(nodeId) == graph.successors(nodeId).end();
+    });
+}
+
+FlankKmerIndex::FlankKmerIndex(const Graph& graph, int kmerLength)
+    : kmerLength_(kmerLength)
+{
+    const KmerIndex kmerIndex(graph, kmerLength_);
+    RollingTwoBitKmerEncoder kmerEncoder(kmerLength_);
+
+    for (const string& kmer : kmerIndex.kmers())
+    {
+        const auto paths = kmerIndex.getPaths(kmer);
+        const bool overlapsFlank = std::any_of(paths.begin(), paths.end(), [&graph](const Path& path) {
+            return checkIfPathOverlapsNonloopNode(graph, path);
+        });
+        if (!overlapsFlank)
+        {
+            continue;
+        }
+
+        kmerEncoder.reset();
+        bool isValidKmer = false;
+        for (char base : kmer)
+        {
+            isValidKmer = kmerEncoder.addBase(base);
+        }
+        if (isValidKmer)
+        {
+            flankKmerKeys_.insert(kmerEncoder.forwardKey());
+        }
+    }
+}
+
+int FlankKmerIndex::countBasesCoveredByFlankKmers(const string& query) const
+{
+    RollingTwoBitKmerEncoder kmerEncoder(kmerLength_);
+    int numCoveredBases = 0;
+    int coveredUntil = 0;
+    for (int position = 0; position != static_cast<int>(query.length()); ++position)
+    {
+        if (!kmerEncoder.addBase(query[position]) || flankKmerKeys_.count(kmerEncoder.forwardKey()) == 0)
+        {
+            continue;
+        }
+
+        const int kmerStart = position + 1 - kmerLength_;
+        numCoveredBases += position + 1 - std::max(kmerStart, coveredUntil);
+        coveredUntil = position + 1;
+    }
+
+    return numCoveredBases;
+}
+
+}
@@ -0,0 +1,54 @@
+//
+// Expansion Hunter
+// Copyright 2016-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#pragma once
+
+#include <string>
+#include <unordered_set>
+
+#include "graphcore/Graph.hh"
+#include "graphutils/KmerEncoding.hh"
+
+namespace ehunter
+{
+
+/// Kmers of graph paths that overlap at least one non-loop (flank) node
+///
+/// A query base aligned as a match to a non-loop node within a run of at least kmerLength matches is covered by a
+/// query kmer from this index. The number of covered bases thus bounds the matches that an alignment can place on
+/// non-loop nodes, except for matches in runs shorter than the kmer, which makes it a cheap estimate of the best
+/// possible non-repeat alignment score of a read.
+class FlankKmerIndex
+{
+public:
+    FlankKmerIndex(const graphtools::Graph& graph, int kmerLength);
+
+    /// Counts query bases covered by kmers that occur on paths overlapping non-loop nodes
+    int countBasesCoveredByFlankKmers(const std::string& query) const;
+
+    int kmerLength() const { return kmerLength_; }
+
+private:
+    int kmerLength_;
+    std::unordered_set<graphtools::TwoBitKmerEncoder::KmerKey_t> flankKmerKeys_;
+};
+
+}
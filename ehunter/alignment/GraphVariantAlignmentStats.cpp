@@ -21,10 +21,13 @@
 
 #include "alignment/GraphVariantAlignmentStats.hh"
 
+#include <array>
 #include <memory>
 
 #include <boost/algorithm/string/join.hpp>
 
+#include "alignment/VariantNodeRole.hh"
+
 namespace ehunter
 {
 
@@ -88,30 +91,20 @@ void GraphVariantAlignmentStatsCalculator::inspect(const GraphAlignment& alignme
 GraphVariantAlignmentStatsCalculator::Flank
 GraphVariantAlignmentStatsCalculator::classify(const GraphAlignment& alignment) const
 {
-    int leftFlankSpan = 0;
-    int variantSpan = 0;
-    int rightFlankSpan = 0;
+    // Reference span of the alignment upstream of, within and downstream of the variant nodes
+    std::array<int, 3> spanByRole = { { 0, 0, 0 } };
 
-    for (int nodeIndex = 0; nodeIndex != static_cast<int>(alignment.path().numNodes()); ++nodeIndex)
+    const auto& path = alignment.path();
+    for (std::size_t nodeIndex = 0; nodeIndex != path.numNodes(); ++nodeIndex)
     {
-        const auto node = alignment.path().getNodeIdByIndex(nodeIndex);
-        const auto& alignmentToNode = alignment.alignments().at(nodeIndex);
-        int nodeSpan = alignmentToNode.referenceLength();
-
-        if (node < firstVariantNode_)
-        {
-            leftFlankSpan += nodeSpan;
-        }
-        else if ((firstVariantNode_ <= node) && (node <= lastVariantNode_))
-        {
-            variantSpan += nodeSpan;
-        }
-        else if (lastVariantNode_ < node)
-        {
-            rightFlankSpan += nodeSpan;
-        }
+        const auto role = getVariantNodeRole(path.getNodeIdByIndex(nodeIndex), firstVariantNode_, lastVariantNode_);
+        spanByRole[static_cast<int>(role)] += alignment[nodeIndex].referenceLength();
     }
 
+    const int leftFlankSpan = spanByRole[static_cast<int>(VariantNodeRole::kUpstream)];
+    const int variantSpan = spanByRole[static_cast<int>(VariantNodeRole::kVariant)];
+    const int rightFlankSpan = spanByRole[static_cast<int>(VariantNodeRole::kDownstream)];
+
     const bool supportsLeftBreakpoint = (leftFlankSpan >= minSpan_) && (variantSpan + rightFlankSpan >= minSpan_);
 
     const bool supportsRightBreakpoint = (variantSpan + leftFlankSpan >= minSpan_) && (rightFlankSpan >= minSpan_);
@@ -29,18 +29,193 @@ namespace ehunter
 {
 
 using boost::optional;
+using graphtools::Alignment;
 using graphtools::Graph;
 using graphtools::GraphAlignment;
-using graphtools::isLocalAlignment;
 using graphtools::NodeId;
+using graphtools::Operation;
+using graphtools::OperationType;
+
+AlignmentWindow::AlignmentWindow(const GraphAlignment& alignment)
+    : alignment_(&alignment)
+    , firstNodeIndex_(0)
+    , lastNodeIndex_(static_cast<int>(alignment.size()) - 1)
+    , startPosition_(alignment.path().startPosition())
+    , endPosition_(alignment.path().endPosition())
+{
+}
+
+AlignmentWindow::AlignmentWindow(
+    const GraphAlignment& alignment, int firstNodeIndex, int lastNodeIndex, int startPosition, int endPosition)
+    : alignment_(&alignment)
+    , firstNodeIndex_(firstNodeIndex)
+    , lastNodeIndex_(lastNodeIndex)
+    , startPosition_(startPosition)
+    , endPosition_(endPosition)
+{
+}
+
+NodeId AlignmentWindow::getNodeIdByIndex(int nodeIndex) const
+{
+    return alignment_->path().getNodeIdByIndex(firstNodeIndex_ + nodeIndex);
+}
+
+int AlignmentWindow::getStartPositionOnNodeByIndex(int nodeIndex) const
+{
+    return nodeIndex == 0 ? startPosition_ : 0;
+}
+
+int AlignmentWindow::getEndPositionOnNodeByIndex(int nodeIndex) const
+{
+    if (nodeIndex == lastNodeIndex_ - firstNodeIndex_)
+    {
+        return endPosition_;
+    }
+    return alignment_->path().getEndPositionOnNodeByIndex(firstNodeIndex_ + nodeIndex);
+}
+
+int AlignmentWindow::getNodeOverlapLengthByIndex(int nodeIndex) const
+{
+    return getEndPositionOnNodeByIndex(nodeIndex) - getStartPositionOnNodeByIndex(nodeIndex);
+}
+
+int AlignmentWindow::countOccurrencesOfNode(NodeId nodeId) const
+{
+    const std::vector<NodeId>& nodeIds = alignment_->path().nodeIds();
+    return std::count(nodeIds.begin() + firstNodeIndex_, nodeIds.begin() + lastNodeIndex_ + 1, nodeId);
+}
+
+AlignmentWindow
+AlignmentWindow::getSubwindow(int firstNodeIndex, int lastNodeIndex, int startPosition, int endPosition) const
+{
+    return AlignmentWindow(
+        *alignment_, firstNodeIndex_ + firstNodeIndex, firstNodeIndex_ + lastNodeIndex, startPosition, endPosition);
+}
+
+static bool startsWithMatch(const Alignment& alignment)
+{
+    for (const Operation& operation : alignment)
+    {
+        if (operation.type() != OperationType::kSoftclip)
+        {
+            return operation.type() == OperationType::kMatch;
+        }
+    }
+    return false;
+}
+
+static bool endsWithMatch(const Alignment& alignment)
+{
+    for (auto operationIter = alignment.operations().rbegin(); operationIter != alignment.operations().rend();
+         ++operationIter)
+    {
+        if (operationIter->type() != OperationType::kSoftclip)
+        {
+            return operationIter->type() == OperationType::kMatch;
+        }
+    }
+    return false;
+}
+
+// The checks below mirror how GraphAlignment::shrinkStart and GraphAlignment::shrinkEnd split a node alignment:
+// operations that do not consume reference and sit at the split position stay with the prefix
+static bool checkIfSuffixStartsWithMatch(const Alignment& alignment, int splitPosition)
+{
+    if (splitPosition == static_cast<int>(alignment.referenceStart()))
+    {
+        return startsWithMatch(alignment);
+    }
+
+    int position = alignment.referenceStart();
+    for (const Operation& operation : alignment)
+    {
+        position += operation.referenceLength();
+        if (position > splitPosition)
+        {
+            return operation.type() == OperationType::kMatch;
+        }
+    }
+    return false;
+}
+
+static bool checkIfPrefixEndsWithMatch(const Alignment& alignment, int splitPosition)
+{
+    if (splitPosition == static_cast<int>(alignment.referenceStart() + alignment.referenceLength()))
+    {
+        return endsWithMatch(alignment);
+    }
+
+    int position = alignment.referenceStart();
+    OperationType lastPrefixOperationType = OperationType::kSoftclip;
+    for (const Operation& operation : alignment)
+    {
+        if (position + static_cast<int>(operation.referenceLength()) > splitPosition)
+        {
+            return position == splitPosition ? lastPrefixOperationType == OperationType::kMatch
+                                             : operation.type() == OperationType::kMatch;
+        }
+
+        position += operation.referenceLength();
+        if (operation.type() != OperationType::kSoftclip)
+        {
+            lastPrefixOperationType = operation.type();
+        }
+    }
+    return false;
+}
+
+bool AlignmentWindow::isLocal() const
+{
+    return checkIfSuffixStartsWithMatch((*alignment_)[firstNodeIndex_], startPosition_)
+        && checkIfPrefixEndsWithMatch((*alignment_)[lastNodeIndex_], endPosition_);
+}
+
+GraphAlignment AlignmentWindow::toAlignment() const
+{
+    const graphtools::Path& path = alignment_->path();
+    GraphAlignment shrankAlignment = *alignment_;
+
+    int leftoverPrefixReferenceLength = 0;
+    for (int nodeIndex = 0; nodeIndex != firstNodeIndex_; ++nodeIndex)
+    {
+        leftoverPrefixReferenceLength += path.getNodeOverlapLengthByIndex(nodeIndex);
+    }
+    leftoverPrefixReferenceLength += startPosition_ - path.getStartPositionOnNodeByIndex(firstNodeIndex_);
+
+    if (leftoverPrefixReferenceLength)
+    {
+        shrankAlignment.shrinkStart(leftoverPrefixReferenceLength);
+    }
+
+    const int numNodes = path.numNodes();
+    int leftoverSuffixReferenceLength = 0;
+    for (int nodeIndex = lastNodeIndex_ + 1; nodeIndex != numNodes; ++nodeIndex)
+    {
+        leftoverSuffixReferenceLength += path.getNodeOverlapLengthByIndex(nodeIndex);
+    }
+    leftoverSuffixReferenceLength += path.getEndPositionOnNodeByIndex(lastNodeIndex_) - endPosition_;
+
+    if (leftoverSuffixReferenceLength)
+    {
+        shrankAlignment.shrinkEnd(leftoverSuffixReferenceLength);
+    }
+
+    return shrankAlignment;
+}
 
 optional<GraphAlignment> GreedyAlignmentIntersector::intersect()
+{
+    const optional<AlignmentWindow> intersection = intersectWindows();
+    return intersection ? intersection->toAlignment() : optional<GraphAlignment>();
+}
+
+optional<AlignmentWindow> GreedyAlignmentIntersector::intersectWindows()
 {
     initialize();
 
     if (!tryAdvancingIndexesToCommonNode())
     {
-        return boost::optional<GraphAlignment>();
+        return optional<AlignmentWindow>();
     }
 
     if (checkIfCommonNodeIsLoop())
@@ -53,10 +228,16 @@ optional<GraphAlignment> GreedyAlignmentIntersector::intersect()
 
     if (!checkIfIntersectionIsConsistent())
     {
-        return boost::optional<GraphAlignment>();
+        return optional<AlignmentWindow>();
     }
 
-    return softclipFirstAlignmentToIntersection();
+    const AlignmentWindow intersection = firstWindow_.getSubwindow(
+        nodeIndexOfIntersectionStartOnFirstPath_, nodeIndexOfIntersectionEndOnFirstPath_, intersectionStart_,
+        intersectionEnd_);
+
+    // Note that the softclipped alignment may not always be a local alignment (that is an alignment that starts and
+    // ends with a match possibly flanked by soft clips). Hence an explicit check below is required.
+    return intersection.isLocal() ? intersection : optional<AlignmentWindow>();
 }
 
 void GreedyAlignmentIntersector::initialize()
@@ -67,7 +248,7 @@ void GreedyAlignmentIntersector::initialize()
 
 bool GreedyAlignmentIntersector::checkIfAlignmentEndReached(int firstPathIndex, int secondPathIndex)
 {
-    return firstPathIndex == (int)firstAlignment_.size() || secondPathIndex == (int)secondAlignment_.size();
+    return firstPathIndex == firstWindow_.numNodes() || secondPathIndex == secondWindow_.numNodes();
 }
 
 bool GreedyAlignmentIntersector::tryAdvancingIndexesToCommonNode()
@@ -75,8 +256,8 @@ bool GreedyAlignmentIntersector::tryAdvancingIndexesToCommonNode()
     while (!checkIfAlignmentEndReached(
         nodeIndexOfIntersectionStartOnFirstPath_, nodeIndexOfIntersectionStartOnSecondPath_))
     {
-        const NodeId firstPathNode = firstPath_.getNodeIdByIndex(nodeIndexOfIntersectionStartOnFirstPath_);
-        const NodeId secondPathNode = secondPath_.getNodeIdByIndex(nodeIndexOfIntersectionStartOnSecondPath_);
+        const NodeId firstPathNode = firstWindow_.getNodeIdByIndex(nodeIndexOfIntersectionStartOnFirstPath_);
+        const NodeId secondPathNode = secondWindow_.getNodeIdByIndex(nodeIndexOfIntersectionStartOnSecondPath_);
 
         if (firstPathNode < secondPathNode)
         {
@@ -98,19 +279,18 @@ bool GreedyAlignmentIntersector::tryAdvancingIndexesToCommonNode()
 
 bool GreedyAlignmentIntersector::checkIfCommonNodeIsLoop() const
 {
-    const NodeId firstPathNode = firstPath_.getNodeIdByIndex(nodeIndexOfIntersectionStartOnFirstPath_);
-    assert(firstPathNode == secondPath_.getNodeIdByIndex(nodeIndexOfIntersectionStartOnSecondPath_));
+    const NodeId firstPathNode = firstWindow_.getNodeIdByIndex(nodeIndexOfIntersectionStartOnFirstPath_);
+    assert(firstPathNode == secondWindow_.getNodeIdByIndex(nodeIndexOfIntersectionStartOnSecondPath_));
 
-    const Graph& graph = *firstPath_.graphRawPtr();
+    const Graph& graph = firstWindow_.graph();
     return graph.hasEdge(firstPathNode, firstPathNode);
 }
 
 void GreedyAlignmentIntersector::advanceIndexesToMatchRemainingIterations()
 {
-    const NodeId loopNodeId = firstPath_.getNodeIdByIndex(nodeIndexOfIntersectionStartOnFirstPath_);
-    // TODO: Move getIndexesOfNode to path class;
-    const int numIterationsMadeByFirstPath = firstAlignment_.getIndexesOfNode(loopNodeId).size();
-    const int numIterationsMadeBySecondPath = secondAlignment_.getIndexesOfNode(loopNodeId).size();
+    const NodeId loopNodeId = firstWindow_.getNodeIdByIndex(nodeIndexOfIntersectionStartOnFirstPath_);
+    const int numIterationsMadeByFirstPath = firstWindow_.countOccurrencesOfNode(loopNodeId);
+    const int numIterationsMadeBySecondPath = secondWindow_.countOccurrencesOfNode(loopNodeId);
 
     if (numIterationsMadeByFirstPath < numIterationsMadeBySecondPath)
     {
@@ -130,8 +310,8 @@ void GreedyAlignmentIntersector::advanceIndexesToLastCommonNode()
     while (!checkIfAlignmentEndReached(
         nodeIndexOfIntersectionEndOnFirstPath_ + 1, nodeIndexOfIntersectionEndOnSecondPath_ + 1))
     {
-        const NodeId firstPathNode = firstPath_.getNodeIdByIndex(nodeIndexOfIntersectionEndOnFirstPath_ + 1);
-        const NodeId secondPathNode = secondPath_.getNodeIdByIndex(nodeIndexOfIntersectionEndOnSecondPath_ + 1);
+        const NodeId firstPathNode = firstWindow_.getNodeIdByIndex(nodeIndexOfIntersectionEndOnFirstPath_ + 1);
+        const NodeId secondPathNode = secondWindow_.getNodeIdByIndex(nodeIndexOfIntersectionEndOnSecondPath_ + 1);
 
         if (firstPathNode == secondPathNode)
         {
@@ -148,57 +328,19 @@ void GreedyAlignmentIntersector::advanceIndexesToLastCommonNode()
 void GreedyAlignmentIntersector::computeIntersectionEnds()
 {
     const int firstPathStartPosition
-        = firstPath_.getStartPositionOnNodeByIndex(nodeIndexOfIntersectionStartOnFirstPath_);
+        = firstWindow_.getStartPositionOnNodeByIndex(nodeIndexOfIntersectionStartOnFirstPath_);
     const int secondPathStartPosition
-        = secondPath_.getStartPositionOnNodeByIndex(nodeIndexOfIntersectionStartOnSecondPath_);
+        = secondWindow_.getStartPositionOnNodeByIndex(nodeIndexOfIntersectionStartOnSecondPath_);
 
     intersectionStart_ = std::max(firstPathStartPosition, secondPathStartPosition);
 
-    const int firstPathEndPosition = firstPath_.getEndPositionOnNodeByIndex(nodeIndexOfIntersectionEndOnFirstPath_);
-    const int secondPathEndPosition = secondPath_.getEndPositionOnNodeByIndex(nodeIndexOfIntersectionEndOnSecondPath_);
+    const int firstPathEndPosition = firstWindow_.getEndPositionOnNodeByIndex(nodeIndexOfIntersectionEndOnFirstPath_);
+    const int secondPathEndPosition
+        = secondWindow_.getEndPositionOnNodeByIndex(nodeIndexOfIntersectionEndOnSecondPath_);
 
     intersectionEnd_ = std::min(firstPathEndPosition, secondPathEndPosition);
 }
 
-optional<GraphAlignment> GreedyAlignmentIntersector::softclipFirstAlignmentToIntersection() const
-{
-    GraphAlignment shrankAlignment = firstAlignment_;
-
-    int leftoverPrefixReferenceLength = 0;
-    for (int nodeIndex = 0; nodeIndex != nodeIndexOfIntersectionStartOnFirstPath_; ++nodeIndex)
-    {
-        leftoverPrefixReferenceLength += firstPath_.getNodeOverlapLengthByIndex(nodeIndex);
-    }
-
-    const int originalStartPosition
-        = firstPath_.getStartPositionOnNodeByIndex(nodeIndexOfIntersectionStartOnFirstPath_);
-    leftoverPrefixReferenceLength += intersectionStart_ - originalStartPosition;
-
-    if (leftoverPrefixReferenceLength)
-    {
-        shrankAlignment.shrinkStart(leftoverPrefixReferenceLength);
-    }
-
-    const int numNodes = firstPath_.numNodes();
-    int leftoverSuffixReferenceLength = 0;
-    for (int nodeIndex = nodeIndexOfIntersectionEndOnFirstPath_ + 1; nodeIndex != numNodes; ++nodeIndex)
-    {
-        leftoverSuffixReferenceLength += firstPath_.getNodeOverlapLengthByIndex(nodeIndex);
-    }
-
-    const int originalEndPosition = firstPath_.getEndPositionOnNodeByIndex(nodeIndexOfIntersectionEndOnFirstPath_);
-    leftoverSuffixReferenceLength += originalEndPosition - intersectionEnd_;
-
-    if (leftoverSuffixReferenceLength)
-    {
-        shrankAlignment.shrinkEnd(leftoverSuffixReferenceLength);
-    }
-
-    // Note that shrankAlignment may not always be a local alignment (that is an alignment that starts and ends with a
-    // match possibly flanked by soft clips). Hence an explicit check below is required.
-    return isLocalAlignment(shrankAlignment) ? shrankAlignment : optional<GraphAlignment>();
-}
-
 bool GreedyAlignmentIntersector::checkIfIntersectionIsConsistent() const
 {
     if (nodeIndexOfIntersectionStartOnFirstPath_ == nodeIndexOfIntersectionEndOnFirstPath_)
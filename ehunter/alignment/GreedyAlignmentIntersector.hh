@@ -28,21 +28,63 @@
 namespace ehunter
 {
 
+/// Part of an alignment that spans path nodes firstNodeIndex through lastNodeIndex, starting at startPosition on the
+/// first of these nodes and ending at endPosition on the last one. A window stands for the alignment that is obtained
+/// by softclipping everything outside of it but does not construct that alignment until toAlignment() is called.
+class AlignmentWindow
+{
+public:
+    explicit AlignmentWindow(const graphtools::GraphAlignment& alignment);
+    AlignmentWindow(
+        const graphtools::GraphAlignment& alignment, int firstNodeIndex, int lastNodeIndex, int startPosition,
+        int endPosition);
+
+    // Node indexes below are relative to the start of the window
+    int numNodes() const { return lastNodeIndex_ - firstNodeIndex_ + 1; }
+    graphtools::NodeId getNodeIdByIndex(int nodeIndex) const;
+    int getStartPositionOnNodeByIndex(int nodeIndex) const;
+    int getEndPositionOnNodeByIndex(int nodeIndex) const;
+    int getNodeOverlapLengthByIndex(int nodeIndex) const;
+    int countOccurrencesOfNode(graphtools::NodeId nodeId) const;
+    const graphtools::Graph& graph() const { return *alignment_->path().graphRawPtr(); }
+
+    AlignmentWindow getSubwindow(int firstNodeIndex, int lastNodeIndex, int startPosition, int endPosition) const;
+
+    /// Checks if the windowed alignment starts and ends with a match possibly flanked by softclips
+    bool isLocal() const;
+    graphtools::GraphAlignment toAlignment() const;
+
+private:
+    const graphtools::GraphAlignment* alignment_;
+    int firstNodeIndex_;
+    int lastNodeIndex_;
+    int startPosition_;
+    int endPosition_;
+};
+
 class GreedyAlignmentIntersector
 {
 public:
     GreedyAlignmentIntersector(
         const graphtools::GraphAlignment& firstAlignment, const graphtools::GraphAlignment& secondAlignment)
-        : firstAlignment_(firstAlignment)
-        , secondAlignment_(secondAlignment)
-        , firstPath_(firstAlignment.path())
-        , secondPath_(secondAlignment.path())
+        : firstWindow_(firstAlignment)
+        , secondWindow_(secondAlignment)
+    {
+        initialize();
+    }
+
+    GreedyAlignmentIntersector(const AlignmentWindow& firstWindow, const AlignmentWindow& secondWindow)
+        : firstWindow_(firstWindow)
+        , secondWindow_(secondWindow)
     {
         initialize();
     }
 
     boost::optional<graphtools::GraphAlignment> intersect();
 
+    /// Same as intersect() but returns the intersection as a window of the first alignment
+    boost::optional<AlignmentWindow> intersectWindows();
+
 private:
     void initialize();
     bool tryAdvancingIndexesToCommonNode();
@@ -52,12 +94,9 @@ private:
     void advanceIndexesToLastCommonNode();
     void computeIntersectionEnds();
     bool checkIfIntersectionIsConsistent() const;
-    boost::optional<graphtools::GraphAlignment> softclipFirstAlignmentToIntersection() const;
 
-    const graphtools::GraphAlignment& firstAlignment_;
-    const graphtools::GraphAlignment& secondAlignment_;
-    const graphtools::Path& firstPath_;
-    const graphtools::Path& secondPath_;
+    AlignmentWindow firstWindow_;
+    AlignmentWindow secondWindow_;
 
     int nodeIndexOfIntersectionStartOnFirstPath_;
     int nodeIndexOfIntersectionStartOnSecondPath_;
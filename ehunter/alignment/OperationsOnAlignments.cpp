@@ -22,6 +22,7 @@
 #include "alignment/OperationsOnAlignments.hh"
 
 #include <cassert>
+#include <iterator>
 #include <list>
 
 #include <boost/optional.hpp>
@@ -37,6 +38,7 @@ using graphtools::Alignment;
 using graphtools::decodeGraphAlignment;
 using graphtools::Graph;
 using graphtools::GraphAlignment;
+using graphtools::isLocalAlignment;
 using graphtools::makeStrGraph;
 using graphtools::mergeAlignments;
 using graphtools::NodeId;
@@ -71,7 +73,7 @@ GraphAlignment extendWithSoftclip(const GraphAlignment& graphAlignment, int left
     return GraphAlignment(graphAlignment.path(), sequenceAlignments);
 }
 
-int getNumNonrepeatMatchesUpstream(NodeId nodeId, GraphAlignment alignment)
+int getNumNonrepeatMatchesUpstream(NodeId nodeId, const GraphAlignment& alignment)
 {
     const list<int> repeatNodeIndexes = alignment.getIndexesOfNode(nodeId);
 
@@ -91,7 +93,7 @@ int getNumNonrepeatMatchesUpstream(NodeId nodeId, GraphAlignment alignment)
     return numMatches;
 }
 
-int getNumNonrepeatMatchesDownstream(NodeId nodeId, GraphAlignment alignment)
+int getNumNonrepeatMatchesDownstream(NodeId nodeId, const GraphAlignment& alignment)
 {
     const list<int> repeatNodeIndexes = alignment.getIndexesOfNode(nodeId);
 
@@ -111,7 +113,7 @@ int getNumNonrepeatMatchesDownstream(NodeId nodeId, GraphAlignment alignment)
     return numMatches;
 }
 
-int scoreAlignmentToNonloopNodes(graphtools::GraphAlignment alignment, LinearAlignmentParameters parameters)
+int scoreAlignmentToNonloopNodes(const graphtools::GraphAlignment& alignment, LinearAlignmentParameters parameters)
 {
     int score = 0;
     const Graph& graph = *alignment.path().graphRawPtr();
@@ -128,7 +130,7 @@ int scoreAlignmentToNonloopNodes(graphtools::GraphAlignment alignment, LinearAli
     return score;
 }
 
-int countFullOverlaps(NodeId nodeId, GraphAlignment alignment)
+int countFullOverlaps(NodeId nodeId, const GraphAlignment& alignment)
 {
     const list<int> repeatNodeIndexes = alignment.getIndexesOfNode(nodeId);
 
@@ -151,25 +153,30 @@ GraphAlignment computeCanonicalAlignment(const list<GraphAlignment>& alignments)
 {
     assert(!alignments.empty());
 
-    if (alignments.size() == 1)
+    // Intersecting an alignment with itself leaves it unchanged if it is local and fails otherwise
+    if (alignments.size() == 1 || !isLocalAlignment(alignments.front()))
     {
         return alignments.front();
     }
 
-    boost::optional<GraphAlignment> canonicalAlignment = alignments.front();
+    // The canonical alignment is always a part of the first alignment, so it is tracked as a window over it and
+    // only softclipped once all intersections are done
+    AlignmentWindow canonicalWindow(alignments.front());
 
-    for (const auto& alignment : alignments)
+    for (auto alignmentIter = std::next(alignments.begin()); alignmentIter != alignments.end(); ++alignmentIter)
     {
-        GreedyAlignmentIntersector alignmentIntersector(*canonicalAlignment, alignment);
-        canonicalAlignment = alignmentIntersector.intersect();
+        GreedyAlignmentIntersector alignmentIntersector(canonicalWindow, AlignmentWindow(*alignmentIter));
+        const boost::optional<AlignmentWindow> intersection = alignmentIntersector.intersectWindows();
 
-        if (!canonicalAlignment)
+        if (!intersection)
         {
             return alignments.front();
         }
+
+        canonicalWindow = *intersection;
     }
 
-    return *canonicalAlignment;
+    return canonicalWindow.toAlignment();
 }
 
 }
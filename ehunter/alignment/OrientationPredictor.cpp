@@ -23,64 +23,97 @@
 
 #include <algorithm>
 #include <iostream>
-#include <list>
-#include <vector>
 
-#include "graphcore/Path.hh"
-#include "graphcore/PathOperations.hh"
-#include "graphutils/SequenceOperations.hh"
+#include "graphutils/KmerEncoding.hh"
 
 using graphtools::KmerIndex;
-using graphtools::Path;
-using std::list;
-using std::string;
-using std::vector;
+using graphtools::RollingTwoBitKmerEncoder;
 
 namespace ehunter
 {
 
-static int countNonoverlappingKmerMatches(const string& query, const KmerIndex& kmerIndex)
+OrientationPrediction OrientationPredictor::predict(const std::string& query) const
+{
+    return predict(query, nullptr);
+}
+
+OrientationPrediction OrientationPredictor::predict(const std::string& query, std::vector<bool>& kmerMatches) const
+{
+    return predict(query, &kmerMatches);
+}
+
+// Kmer matches are counted greedily on each strand skipping kmers that overlap the previous counted match. Because all
+// kmers have the same length, the greedy count is the maximum number of non-overlapping matches and so does not depend
+// on the scan direction; this allows both strands to be counted while scanning the query left-to-right.
+OrientationPrediction OrientationPredictor::predict(const std::string& query, std::vector<bool>* kmerMatches) const
 {
-    const std::size_t kmerLength = kmerIndex.kmerLength();
-    int matchCount = 0;
-    size_t position = 0;
-    while (position + kmerLength <= query.length())
+    const size_t kmerLength = static_cast<size_t>(kmerLength_);
+    const size_t numKmers = query.length() < kmerLength ? 0 : query.length() - kmerLength + 1;
+    if (kmerMatches)
     {
-        string kmer = query.substr(position, kmerLength);
-        std::transform(kmer.begin(), kmer.end(), kmer.begin(), ::toupper);
+        // Forward-strand flags followed by reverse-complement-strand flags
+        kmerMatches->assign(2 * numKmers, false);
+    }
 
-        if (kmerIndex.contains(kmer))
+    RollingTwoBitKmerEncoder kmerEncoder(kmerLength);
+    int numForwardMatches = 0;
+    int numReverseComplementMatches = 0;
+    size_t nextForwardKmerStart = 0;
+    size_t nextReverseComplementKmerStart = 0;
+    for (size_t position = 0; position != query.length(); ++position)
+    {
+        if (!kmerEncoder.addBase(query[position]))
         {
-            ++matchCount;
-            position += kmerLength;
+            continue;
         }
-        else
+
+        const size_t kmerStart = position + 1 - kmerLength;
+        const bool isForwardMatch = kmerIndex_.containsKey(kmerEncoder.forwardKey());
+        const bool isReverseComplementMatch = kmerIndex_.containsKey(kmerEncoder.reverseComplementKey());
+
+        if (isForwardMatch && kmerStart >= nextForwardKmerStart)
         {
-            ++position;
+            ++numForwardMatches;
+            nextForwardKmerStart = kmerStart + kmerLength;
+        }
+        if (isReverseComplementMatch && kmerStart >= nextReverseComplementKmerStart)
+        {
+            ++numReverseComplementMatches;
+            nextReverseComplementKmerStart = kmerStart + kmerLength;
         }
-    }
-    return matchCount;
-}
 
-OrientationPrediction OrientationPredictor::predict(const std::string& query) const
-{
-    const int numForwardMatches = countNonoverlappingKmerMatches(query, kmerIndex_);
-    const int numReverseComplementMatches
-        = countNonoverlappingKmerMatches(graphtools::reverseComplement(query), kmerIndex_);
+        if (kmerMatches)
+        {
+            (*kmerMatches)[kmerStart] = isForwardMatch;
+            (*kmerMatches)[2 * numKmers - 1 - kmerStart] = isReverseComplementMatch;
+        }
+    }
 
     const int maxMatches = std::max(numForwardMatches, numReverseComplementMatches);
 
     if (maxMatches < minKmerMatchesToPass_)
     {
+        if (kmerMatches)
+        {
+            kmerMatches->clear();
+        }
         return OrientationPrediction::kDoesNotAlign;
     }
 
     if (numForwardMatches >= numReverseComplementMatches)
     {
+        if (kmerMatches)
+        {
+            kmerMatches->resize(numKmers);
+        }
         return OrientationPrediction::kAlignsInOriginalOrientation;
     }
     else
     {
+        if (kmerMatches)
+        {
+            kmerMatches->erase(kmerMatches->begin(), kmerMatches->begin() + numKmers);
+        }
         return OrientationPrediction::kAlignsInReverseComplementOrientation;
     }
 }
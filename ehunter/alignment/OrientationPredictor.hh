@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <iosfwd>
 #include <string>
+#include <vector>
 
 #include "graphalign/KmerIndex.hh"
 #include "graphcore/Graph.hh"
@@ -53,7 +54,19 @@ public:
 
     OrientationPrediction predict(const std::string& query) const;
 
+    /// Predicts orientation and reports which kmers of the query occur in the graph
+    ///
+    /// Both strands are scanned in a single pass. On success, the flag at position i of kmerMatches indicates if the
+    /// kmer starting at position i of the query, taken in the predicted orientation, occurs in the graph.
+    ///
+    /// \param[out] kmerMatches Kmer match flags; cleared if the query is not predicted to align
+    OrientationPrediction predict(const std::string& query, std::vector<bool>& kmerMatches) const;
+
+    int kmerLength() const { return kmerLength_; }
+
 private:
+    OrientationPrediction predict(const std::string& query, std::vector<bool>* kmerMatches) const;
+
     int32_t kmerLength_;
     int32_t minKmerMatchesToPass_;
     graphtools::KmerIndex kmerIndex_;
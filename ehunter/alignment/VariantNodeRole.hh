@@ -0,0 +1,48 @@
+//
+// Expansion Hunter
+// Copyright 2016-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#pragma once
+
+#include <cstdint>
+
+#include "graphcore/Graph.hh"
+
+namespace ehunter
+{
+
+/// Position of a graph node relative to a bundle of consecutive variant nodes
+enum class VariantNodeRole : uint8_t
+{
+    kUpstream = 0,
+    kVariant = 1,
+    kDownstream = 2
+};
+
+/// Nodes of locus graphs are numbered in topological order, so the role of a node follows from two comparisons
+/// without branching
+inline VariantNodeRole
+getVariantNodeRole(graphtools::NodeId node, graphtools::NodeId firstVariantNode, graphtools::NodeId lastVariantNode)
+{
+    return static_cast<VariantNodeRole>((node >= firstVariantNode) + (node > lastVariantNode));
+}
+
+}
@@ -22,6 +22,7 @@
 
 #include "core/CountTable.hh"
 
+#include <algorithm>
 #include <stdexcept>
 
 using std::string;
@@ -31,21 +32,52 @@ using std::vector;
 namespace ehunter
 {
 
+namespace
+{
+bool elementLess(const CountTable::ElementAndCount& elementAndCount, int32_t element)
+{
+    return elementAndCount.first < element;
+}
+}
+
+vector<CountTable::ElementAndCount>::iterator CountTable::lowerBound(int32_t element)
+{
+    return std::lower_bound(elementsToCounts_.begin(), elementsToCounts_.end(), element, elementLess);
+}
+
+vector<CountTable::ElementAndCount>::const_iterator CountTable::lowerBound(int32_t element) const
+{
+    return std::lower_bound(elementsToCounts_.begin(), elementsToCounts_.end(), element, elementLess);
+}
+
 int32_t CountTable::countOf(int32_t element) const
 {
-    if (elementsToCounts_.find(element) == elementsToCounts_.end())
+    const auto it = lowerBound(element);
+    if (it == elementsToCounts_.end() || it->first != element)
     {
         return 0;
     }
-    return elementsToCounts_.at(element);
+    return it->second;
 }
 
 void CountTable::setCountOf(int32_t element, int32_t count)
 {
-    elementsToCounts_[element] = count;
+    auto it = lowerBound(element);
+    const bool containsElement = it != elementsToCounts_.end() && it->first == element;
     if (count == 0)
     {
-        elementsToCounts_.erase(element);
+        if (containsElement)
+        {
+            elementsToCounts_.erase(it);
+        }
+    }
+    else if (containsElement)
+    {
+        it->second = count;
+    }
+    else
+    {
+        elementsToCounts_.emplace(it, element, count);
     }
 }
 
@@ -56,12 +88,28 @@ void CountTable::incrementCountOf(int32_t element, int32_t increment)
         throw std::logic_error("CountTables require positive increments");
     }
 
-    elementsToCounts_[element] += increment;
+    // Elements are often added in increasing order
+    if (elementsToCounts_.empty() || elementsToCounts_.back().first < element)
+    {
+        elementsToCounts_.emplace_back(element, increment);
+        return;
+    }
+
+    auto it = lowerBound(element);
+    if (it->first == element)
+    {
+        it->second += increment;
+    }
+    else
+    {
+        elementsToCounts_.emplace(it, element, increment);
+    }
 }
 
 vector<int32_t> CountTable::getElementsWithNonzeroCounts() const
 {
     vector<int32_t> elements;
+    elements.reserve(elementsToCounts_.size());
     for (const auto& element_count : elementsToCounts_)
     {
         elements.push_back(element_count.first);
@@ -84,7 +132,7 @@ std::ostream& operator<<(std::ostream& out, const CountTable& count_table)
 {
     string encoding;
 
-    for (int32_t element : count_table.getElementsWithNonzeroCounts())
+    for (const auto& elementAndCount : count_table)
     {
 
         if (!encoding.empty())
@@ -92,7 +140,7 @@ std::ostream& operator<<(std::ostream& out, const CountTable& count_table)
             encoding += ", ";
         }
 
-        encoding += "(" + to_string(element) + ", " + to_string(count_table.countOf(element)) + ")";
+        encoding += "(" + to_string(elementAndCount.first) + ", " + to_string(elementAndCount.second) + ")";
     }
 
     if (encoding.empty())
@@ -114,9 +162,10 @@ CountTable collapseTopElements(const CountTable& countTable, int upperBound)
 
     CountTable truncatedTable;
 
-    for (auto element : countTable.getElementsWithNonzeroCounts())
+    for (const auto& elementAndCount : countTable)
     {
-        auto count = countTable.countOf(element);
+        const auto element = elementAndCount.first;
+        const auto count = elementAndCount.second;
 
         if (element < upperBound)
         {
@@ -26,22 +26,27 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace ehunter
 {
 
+// Count tables hold few distinct elements (e.g. repeat sizes), so they are stored as a vector of (element, count) pairs
+// sorted by element
 class CountTable
 {
 public:
-    using const_iterator = std::map<int32_t, int32_t>::const_iterator;
+    using ElementAndCount = std::pair<int32_t, int32_t>;
+    using const_iterator = std::vector<ElementAndCount>::const_iterator;
     const_iterator begin() const { return elementsToCounts_.begin(); }
     const_iterator end() const { return elementsToCounts_.end(); }
 
     CountTable() = default;
-    explicit CountTable(std::map<int32_t, int32_t> elementsToCounts)
-        : elementsToCounts_(std::move(elementsToCounts)) {};
+    explicit CountTable(const std::map<int32_t, int32_t>& elementsToCounts)
+        : elementsToCounts_(elementsToCounts.begin(), elementsToCounts.end()) {};
     CountTable(const CountTable& other) = default;
+    CountTable(CountTable&& other) = default;
 
     void clear() { elementsToCounts_.clear(); }
 
@@ -51,10 +56,14 @@ public:
     std::vector<int32_t> getElementsWithNonzeroCounts() const;
 
     CountTable& operator=(const CountTable& other);
+    CountTable& operator=(CountTable&& other) = default;
     bool operator==(const CountTable& other) const { return elementsToCounts_ == other.elementsToCounts_; }
 
 private:
-    std::map<int32_t, int32_t> elementsToCounts_;
+    std::vector<ElementAndCount>::iterator lowerBound(int32_t element);
+    std::vector<ElementAndCount>::const_iterator lowerBound(int32_t element) const;
+
+    std::vector<ElementAndCount> elementsToCounts_;
 };
 
 std::ostream& operator<<(std::ostream& out, const CountTable& count_table);
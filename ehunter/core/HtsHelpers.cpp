@@ -141,6 +141,18 @@ Read decodeRead(bam1_t* htsAlignPtr)
     return { std::move(readId), std::move(bases), isReversed };
 }
 
+void decodeBasesAsLowQuality(bam1_t* htsAlignPtr, string& bases)
+{
+    const uint8_t* htsSeqPtr = bam_get_seq(htsAlignPtr);
+    const int32_t readLength = htsAlignPtr->core.l_qseq;
+    bases.resize(readLength);
+
+    for (int32_t index = 0; index < readLength; ++index)
+    {
+        bases[index] = seq_nt16_str_lc.data[bam_seqi(htsSeqPtr, index)];
+    }
+}
+
 ReferenceContigInfo decodeContigInfo(bam_hdr_t* htsHeaderPtr)
 {
     vector<pair<string, int64_t>> contigNamesAndSizes;
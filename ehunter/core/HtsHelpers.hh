@@ -40,6 +40,9 @@ namespace htshelpers
 LinearAlignmentStats decodeAlignmentStats(bam1_t* htsAlignPtr);
 bool isPrimaryAlignment(bam1_t* htsAlignPtr);
 Read decodeRead(bam1_t* htsAlignPtr);
+
+/// Decodes read bases as if all of them were of low quality (in lowercase) reusing the storage of \p bases
+void decodeBasesAsLowQuality(bam1_t* htsAlignPtr, std::string& bases);
 ReferenceContigInfo decodeContigInfo(bam_hdr_t* htsHeaderPtr);
 
 } // namespace htshelpers
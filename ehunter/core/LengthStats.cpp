@@ -0,0 +1,91 @@
+//
+// Expansion Hunter
+// Copyright 2016-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#include "core/LengthStats.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ehunter
+{
+
+const int LengthStats::kMaxBinnedLength;
+
+void LengthStats::add(int length)
+{
+    ++count_;
+    sum_ += length;
+
+    const auto binIndex = static_cast<std::size_t>(std::min(std::max(length, 0), kMaxBinnedLength));
+    if (binIndex >= histogram_.size())
+    {
+        histogram_.resize(binIndex + 1, 0);
+    }
+    ++histogram_[binIndex];
+}
+
+void LengthStats::merge(const LengthStats& other)
+{
+    count_ += other.count_;
+    sum_ += other.sum_;
+
+    if (other.histogram_.size() > histogram_.size())
+    {
+        histogram_.resize(other.histogram_.size(), 0);
+    }
+    for (std::size_t binIndex = 0; binIndex != other.histogram_.size(); ++binIndex)
+    {
+        histogram_[binIndex] += other.histogram_[binIndex];
+    }
+}
+
+double LengthStats::mean() const { return count_ == 0 ? 0.0 : static_cast<double>(sum_) / count_; }
+
+int LengthStats::quantile(double fraction) const
+{
+    if (count_ == 0)
+    {
+        return 0;
+    }
+
+    const auto rank = std::max(static_cast<int64_t>(std::ceil(fraction * count_)), static_cast<int64_t>(1));
+    int64_t cumulativeCount = 0;
+    for (std::size_t binIndex = 0; binIndex != histogram_.size(); ++binIndex)
+    {
+        cumulativeCount += histogram_[binIndex];
+        if (cumulativeCount >= rank)
+        {
+            return static_cast<int>(binIndex);
+        }
+    }
+
+    return static_cast<int>(histogram_.size()) - 1;
+}
+
+std::ostream& operator<<(std::ostream& out, const LengthStats& stats)
+{
+    out << "LengthStats(count=" << stats.count() << ", mean=" << stats.mean() << ", q05=" << stats.quantile(0.05)
+        << ", median=" << stats.median() << ", q95=" << stats.quantile(0.95) << ")";
+    return out;
+}
+
+}
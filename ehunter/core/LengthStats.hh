@@ -0,0 +1,63 @@
+//
+// Expansion Hunter
+// Copyright 2016-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace ehunter
+{
+
+/// \brief Streaming summary of a length distribution
+///
+/// Lengths are counted in a histogram with one bin per base, which grows only as far as the longest length seen, so
+/// medians and other quantiles are exact. Lengths beyond kMaxBinnedLength are counted in the last bin; they are still
+/// included in the mean. Summaries from different loci or threads can be merged into one.
+///
+class LengthStats
+{
+public:
+    static const int kMaxBinnedLength = 10000;
+
+    void add(int length);
+    void merge(const LengthStats& other);
+
+    int64_t count() const { return count_; }
+    int64_t sum() const { return sum_; }
+    /// Mean length, or 0 if no lengths were added
+    double mean() const;
+    /// Smallest length such that at least the given fraction of all lengths are less or equal to it, or 0 if no
+    /// lengths were added
+    int quantile(double fraction) const;
+    int median() const { return quantile(0.5); }
+
+private:
+    int64_t count_ = 0;
+    int64_t sum_ = 0;
+    std::vector<uint32_t> histogram_;
+};
+
+std::ostream& operator<<(std::ostream& out, const LengthStats& stats);
+
+}
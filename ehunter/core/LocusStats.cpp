@@ -80,7 +80,7 @@ static AlleleCount determineExpectedAlleleCount(ChromType chromType, Sex sex)
 
 LocusStats LocusStatsCalculator::estimate(Sex sampleSex)
 {
-    const int readCount = boost::accumulators::count(readLengthAccumulator_);
+    const int readCount = readLengthStats_.count();
     AlleleCount alleleCount = determineExpectedAlleleCount(chromType_, sampleSex);
 
     if (readCount == 0)
@@ -88,18 +88,11 @@ LocusStats LocusStatsCalculator::estimate(Sex sampleSex)
         return { alleleCount, 0, 0, 0.0 };
     }
 
-    const int meanReadLength = boost::accumulators::mean(readLengthAccumulator_);
+    const int meanReadLength = readLengthStats_.mean();
     const int numberOfStartPositions = leftFlankLength_ + rightFlankLength_ - meanReadLength;
     const double depth = meanReadLength * (static_cast<double>(readCount) / numberOfStartPositions);
 
-    int meanFragLen = 0;
-    const int fragCount = boost::accumulators::count(fragLengthAccumulator_);
-    if (fragCount != 0)
-    {
-        meanFragLen = boost::accumulators::mean(fragLengthAccumulator_);
-    }
-
-    return { alleleCount, meanReadLength, meanFragLen, depth };
+    return { alleleCount, meanReadLength, fragLengthStats_.median(), depth };
 }
 
 void LocusStatsCalculator::recordReadLen(const GraphAlignment& readAlign)
@@ -107,7 +100,7 @@ void LocusStatsCalculator::recordReadLen(const GraphAlignment& readAlign)
     const graphtools::NodeId firstNode = readAlign.path().getNodeIdByIndex(0);
     if (firstNode == leftFlankId_ || firstNode == rightFlankId_)
     {
-        readLengthAccumulator_(readAlign.queryLength());
+        readLengthStats_.add(readAlign.queryLength());
     }
 }
 
@@ -131,11 +124,11 @@ void LocusStatsCalculator::recordFragLen(const GraphAlignment& readAlign, const
 
     if (readEnd < mateEnd)
     {
-        fragLengthAccumulator_(mateEnd - readStart);
+        fragLengthStats_.add(mateEnd - readStart);
     }
     else if (mateEnd < readEnd)
     {
-        fragLengthAccumulator_(readEnd - mateStart);
+        fragLengthStats_.add(readEnd - mateStart);
     }
 }
 
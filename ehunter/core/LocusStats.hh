@@ -25,14 +25,12 @@
 #include <string>
 #include <vector>
 
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics.hpp>
-
 #include "graphalign/GraphAlignment.hh"
 #include "graphcore/Graph.hh"
 
 #include "core/Common.hh"
 #include "core/GenomicRegion.hh"
+#include "core/LengthStats.hh"
 #include "core/Reference.hh"
 
 namespace ehunter
@@ -79,16 +77,15 @@ public:
     LocusStats estimate(Sex sampleSex);
     void recordReadLen(const graphtools::GraphAlignment& readAlign);
 
-private:
-    using AccumulatorStats
-        = boost::accumulators::features<boost::accumulators::tag::count, boost::accumulators::tag::mean>;
-    using Accumulator = boost::accumulators::accumulator_set<int, AccumulatorStats>;
+    const LengthStats& readLengthStats() const { return readLengthStats_; }
+    const LengthStats& fragLengthStats() const { return fragLengthStats_; }
 
+private:
     void recordFragLen(const graphtools::GraphAlignment& readAlign, const graphtools::GraphAlignment& mateAlign);
 
     ChromType chromType_;
-    Accumulator readLengthAccumulator_;
-    Accumulator fragLengthAccumulator_;
+    LengthStats readLengthStats_;
+    LengthStats fragLengthStats_;
     graphtools::NodeId leftFlankId_;
     graphtools::NodeId rightFlankId_;
     int leftFlankLength_;
@@ -21,6 +21,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
 #include <boost/math/special_functions/log1p.hpp>
 
 // returns log(1+x), switches to log1p function when abs(x) is small
@@ -46,4 +51,89 @@ static double getLogSum(double x1, double x2)
     if (x1 < x2)
         std::swap(x1, x2);
     return x1 + log1p_switch(std::exp(x2 - x1));
-}
\ No newline at end of file
+}
+
+// Returns the equivalent of log(exp(x[0]) + ... + exp(x[numValues - 1])), or -infinity if there are no values
+inline double getLogSum(const double* values, std::size_t numValues)
+{
+    if (numValues == 0)
+    {
+        return -std::numeric_limits<double>::infinity();
+    }
+
+    const double maxValue = *std::max_element(values, values + numValues);
+    if (std::isinf(maxValue))
+    {
+        return maxValue;
+    }
+
+    double sum = 0;
+    for (std::size_t index = 0; index != numValues; ++index)
+    {
+        sum += std::exp(values[index] - maxValue);
+    }
+    return maxValue + std::log(sum);
+}
+
+// Returns the sum over all indexes of getLogSum(x1[index], x2Offset + x2[index])
+//
+// Each term is evaluated without swapping its arguments, so the loop has no data-dependent branches besides the one in
+// log1p_switch; the result is identical to summing the getLogSum terms.
+inline double sumLogSums(const double* x1, const double* x2, double x2Offset, std::size_t numValues)
+{
+    double sum = 0;
+    for (std::size_t index = 0; index != numValues; ++index)
+    {
+        const double y1 = x1[index];
+        const double y2 = x2Offset + x2[index];
+        sum += std::max(y1, y2) + log1p_switch(std::exp(-std::abs(y1 - y2)));
+    }
+    return sum;
+}
+
+// Table of log(1 + exp(-d)) for 0 <= d <= kMaxDiff in steps of 1 / kStepsPerUnit
+class Log1pExpNegTable
+{
+public:
+    static const int kStepsPerUnit = 64;
+    static const int kMaxDiff = 12;
+
+    Log1pExpNegTable()
+    {
+        for (int index = 0; index != kNumEntries; ++index)
+        {
+            entries_[index] = boost::math::log1p(std::exp(-static_cast<double>(index) / kStepsPerUnit));
+        }
+    }
+
+    // Linearly interpolated value at 0 <= diff < kMaxDiff
+    double interpolate(double diff) const
+    {
+        const double position = diff * kStepsPerUnit;
+        const int index = static_cast<int>(position);
+        const double fraction = position - index;
+        return entries_[index] + fraction * (entries_[index + 1] - entries_[index]);
+    }
+
+private:
+    static const int kNumEntries = kMaxDiff * kStepsPerUnit + 1;
+    double entries_[kNumEntries];
+};
+
+// Fast approximation of getLogSum with absolute error below 1e-5
+//
+// The second derivative of log(1 + exp(-d)) is at most 1/4, so interpolating it linearly between table entries
+// 1/64 apart is accurate to (1/64)^2 / 32 < 7.7e-6. Beyond d = 12 the term is dropped, which is accurate to
+// exp(-12) < 6.2e-6. Use where many terms are summed and the exact value is not reported.
+inline double getLogSumFast(double x1, double x2)
+{
+    static const Log1pExpNegTable log1pExpNegTable;
+
+    const double maxValue = std::max(x1, x2);
+    const double diff = std::abs(x1 - x2);
+    if (!(diff < Log1pExpNegTable::kMaxDiff))
+    {
+        return maxValue;
+    }
+    return maxValue + log1pExpNegTable.interpolate(diff);
+}
@@ -110,7 +110,7 @@ public:
 
     void reverseComplement()
     {
-        sequence_ = graphtools::reverseComplement(sequence_);
+        sequence_ = graphtools::reverseComplement(std::move(sequence_));
         isReversed_ = !isReversed_;
     }
 
@@ -33,15 +33,17 @@ int countConsistentReads(const CountTable& table, int alleleSize)
 {
     int readCount = 0;
 
+    // Count tables are sorted by size
     for (const auto& sizeAndCount : table)
     {
         const int size = sizeAndCount.first;
         const int count = sizeAndCount.second;
 
-        if (size <= alleleSize)
+        if (size > alleleSize)
         {
-            readCount += count;
+            break;
         }
+        readCount += count;
     }
 
     return readCount;
@@ -23,15 +23,11 @@
 
 #include <algorithm>
 #include <array>
-#include <stdexcept>
-#include <unordered_map>
-
-#include <boost/algorithm/string.hpp>
+#include <limits>
 
 #include "graphutils/SequenceOperations.hh"
 
 using std::string;
-using std::to_string;
 using std::vector;
 
 namespace ehunter
@@ -115,56 +111,100 @@ const std::array<std::array<double, kMaxQueryBaseCode + 1>, kMaxReferenceBaseCod
         // clang-format on
     };
 
-static inline double scoreBases(char referenceBase, char queryBase)
-{
-    return kReferenceQueryCodeScoreLookupTable[kReferenceBaseEncodingTable[referenceBase]]
-                                              [kQueryBaseEncodingTable[queryBase]];
-}
 }
 
 WeightedPurityCalculator::WeightedPurityCalculator(const std::string& repeatUnit)
+    : repeatUnitLength_(repeatUnit.length())
 {
-    repeatUnits_ = computeCircularPermutations(repeatUnit);
-    const string repeatUnitRc = graphtools::reverseComplement(repeatUnit);
-    auto permutationsRc = computeCircularPermutations(repeatUnitRc);
-    repeatUnits_.insert(repeatUnits_.end(), permutationsRc.begin(), permutationsRc.end());
-}
+    static_assert(kNumQueryBaseCodes == irrdetection::kMaxQueryBaseCode + 1, "Unexpected number of query base codes");
 
-double WeightedPurityCalculator::score(const string& querySequence) const
-{
-    vector<double> scores;
-    for (const auto& repeatUnit : repeatUnits_)
+    vector<irrdetection::BaseCode> distinctBaseCodes;
+    const string repeatUnitRc = graphtools::reverseComplement(repeatUnit);
+    for (const string& strand : { repeatUnit, repeatUnitRc })
     {
-        scores.push_back(score(repeatUnit, querySequence));
+        for (const char base : strand)
+        {
+            const irrdetection::BaseCode baseCode
+                = irrdetection::kReferenceBaseEncodingTable[static_cast<unsigned char>(base)];
+            auto baseCodeIter = std::find(distinctBaseCodes.begin(), distinctBaseCodes.end(), baseCode);
+            if (baseCodeIter == distinctBaseCodes.end())
+            {
+                distinctBaseCodes.push_back(baseCode);
+                baseCodeIter = distinctBaseCodes.end() - 1;
+            }
+            repeatUnitBaseIndexes_.push_back(baseCodeIter - distinctBaseCodes.begin());
+        }
     }
 
-    const double weightedPurity
-        = *std::max_element(scores.begin(), scores.end()) / static_cast<double>(querySequence.length());
-    return weightedPurity;
+    // All scores are multiples of 0.5
+    for (const irrdetection::BaseCode baseCode : distinctBaseCodes)
+    {
+        QueryBaseScores scores;
+        for (int queryBaseCode = 0; queryBaseCode != kNumQueryBaseCodes; ++queryBaseCode)
+        {
+            scores[queryBaseCode]
+                = static_cast<int>(2 * irrdetection::kReferenceQueryCodeScoreLookupTable[baseCode][queryBaseCode]);
+        }
+        referenceBaseScores_.push_back(scores);
+    }
 }
 
-double WeightedPurityCalculator::score(const std::string& repeatUnit, const std::string& querySequence) const
+double WeightedPurityCalculator::score(const string& querySequence) const
 {
-    double score = 0;
-    for (int position = 0; position != static_cast<int>(querySequence.length()); ++position)
+    // Count query bases at each offset within the repeat unit
+    vector<int> baseCounts(repeatUnitLength_ * kNumQueryBaseCodes, 0);
+    int queryOffset = 0;
+    for (const char base : querySequence)
     {
-        const int offset = position % repeatUnit.length();
-        score += irrdetection::scoreBases(repeatUnit[offset], querySequence[position]);
+        const int queryBaseCode = irrdetection::kQueryBaseEncodingTable[static_cast<unsigned char>(base)];
+        ++baseCounts[queryOffset * kNumQueryBaseCodes + queryBaseCode];
+        if (++queryOffset == repeatUnitLength_)
+        {
+            queryOffset = 0;
+        }
     }
 
-    return score;
-}
+    // Score the bases at each offset against each distinct base of the repeat unit
+    const int numReferenceBases = referenceBaseScores_.size();
+    vector<int> offsetScores(repeatUnitLength_ * numReferenceBases, 0);
+    for (int offset = 0; offset != repeatUnitLength_; ++offset)
+    {
+        const int* offsetBaseCounts = &baseCounts[offset * kNumQueryBaseCodes];
+        for (int referenceBaseIndex = 0; referenceBaseIndex != numReferenceBases; ++referenceBaseIndex)
+        {
+            const QueryBaseScores& scores = referenceBaseScores_[referenceBaseIndex];
+            int offsetScore = 0;
+            for (int queryBaseCode = 0; queryBaseCode != kNumQueryBaseCodes; ++queryBaseCode)
+            {
+                offsetScore += offsetBaseCounts[queryBaseCode] * scores[queryBaseCode];
+            }
+            offsetScores[offset * numReferenceBases + referenceBaseIndex] = offsetScore;
+        }
+    }
 
-vector<string> WeightedPurityCalculator::computeCircularPermutations(string sequence) const
-{
-    vector<string> permutations = { sequence };
-    for (int rotationNum = 0; rotationNum != static_cast<int>(sequence.length()) - 1; ++rotationNum)
+    // Offset i of the query is compared to base (i + rotation) % length of a repeat unit strand
+    int topScore = std::numeric_limits<int>::lowest();
+    for (int strandStart = 0; strandStart != 2 * repeatUnitLength_; strandStart += repeatUnitLength_)
     {
-        std::rotate(sequence.begin(), sequence.begin() + 1, sequence.end());
-        permutations.push_back(sequence);
+        for (int rotation = 0; rotation != repeatUnitLength_; ++rotation)
+        {
+            int score = 0;
+            int unitOffset = rotation;
+            for (int offset = 0; offset != repeatUnitLength_; ++offset)
+            {
+                const int referenceBaseIndex = repeatUnitBaseIndexes_[strandStart + unitOffset];
+                score += offsetScores[offset * numReferenceBases + referenceBaseIndex];
+                if (++unitOffset == repeatUnitLength_)
+                {
+                    unitOffset = 0;
+                }
+            }
+            topScore = std::max(topScore, score);
+        }
     }
 
-    return permutations;
+    const double weightedPurity = (topScore / 2.0) / static_cast<double>(querySequence.length());
+    return weightedPurity;
 }
 
 }
@@ -20,12 +20,17 @@
 //
 
 #pragma once
+#include <array>
 #include <string>
 #include <vector>
 
 namespace ehunter
 {
 
+/// Purity of a sequence with respect to a repeat unit
+///
+/// The query is compared to repeats made of every rotation of the unit and of its reverse complement. Base counts of
+/// the query are collected in a single pass per offset within the unit, and all rotations are scored from these counts.
 class WeightedPurityCalculator
 {
 public:
@@ -33,9 +38,14 @@ public:
     double score(const std::string& querySequence) const;
 
 private:
-    double score(const std::string& repeatUnit, const std::string& querySequence) const;
-    std::vector<std::string> computeCircularPermutations(std::string sequence) const;
-    std::vector<std::string> repeatUnits_;
+    static const int kNumQueryBaseCodes = 9;
+    using QueryBaseScores = std::array<int, kNumQueryBaseCodes>;
+
+    int repeatUnitLength_;
+    // Scores (doubled to make them integer) of query bases against each distinct base of the repeat unit strands
+    std::vector<QueryBaseScores> referenceBaseScores_;
+    // Indexes into referenceBaseScores_ of the bases of the repeat unit followed by those of its reverse complement
+    std::vector<int> repeatUnitBaseIndexes_;
 };
 
 }
@@ -23,8 +23,9 @@
 
 #include <algorithm>
 #include <cassert>
-
 #include <numeric>
+#include <stdexcept>
+#include <string>
 
 using graphtools::GraphAlignment;
 using std::vector;
@@ -40,28 +41,53 @@ AlignMatrix::AlignMatrix(int strNode)
 {
 }
 
-StrAlign AlignMatrix::getAlign(int readIndex, int alleleSize) const
+const AlignMatrix::Row& AlignMatrix::getRow(int readIndex) const
 {
-    if (readIndex >= static_cast<int>(alignScoreMatrix_.size()))
+    if (readIndex < 0 || readIndex >= static_cast<int>(rows_.size()))
     {
         throw std::runtime_error("Encountered invalid alignment matrix index " + std::to_string(readIndex));
     }
 
-    if (alleleSize < static_cast<int>(alignScoreMatrix_[readIndex].size()))
-    {
-        return alignScoreMatrix_[readIndex][alleleSize];
-    }
-    else
+    const Row& row = rows_[readIndex];
+    assert(!row.isRemoved);
+    return row;
+}
+
+StrAlign AlignMatrix::getAlign(int readIndex, int alleleSize) const
+{
+    const Row& row = getRow(readIndex);
+    assert(row.length != 0);
+    return aligns_[row.offset + std::min(alleleSize, row.length - 1)];
+}
+
+StrAlign AlignMatrix::getBestAlign(int readIndex) const
+{
+    const Row& row = getRow(readIndex);
+    return aligns_[row.offset + row.bestAlleleSize];
+}
+
+int AlignMatrix::getRowLength(int readIndex) const { return getRow(readIndex).length; }
+
+void AlignMatrix::getAlignsToAllele(int alleleSize, vector<StrAlign>& aligns) const
+{
+    aligns.clear();
+    aligns.reserve(rows_.size());
+    for (const Row& row : rows_)
     {
-        assert(!alignScoreMatrix_[readIndex].empty());
-        return alignScoreMatrix_[readIndex].back();
+        assert(!row.isRemoved);
+        aligns.push_back(aligns_[row.offset + std::min(alleleSize, row.length - 1)]);
     }
 }
 
 void AlignMatrix::add(const GraphAlignment& read, const GraphAlignment& mate)
 {
-    const int numMotifsInRead = std::count(read.path().begin(), read.path().end(), strNode_);
-    const int numMorifsInMate = std::count(mate.path().begin(), mate.path().end(), strNode_);
+    add(AlignmentScoreSummary(read), AlignmentScoreSummary(mate));
+}
+
+void AlignMatrix::add(const AlignmentScoreSummary& read, const AlignmentScoreSummary& mate)
+{
+    const int numMotifsInRead = read.countOccurrencesOfNode(strNode_);
+    const int numMorifsInMate = mate.countOccurrencesOfNode(strNode_);
 
     if (numMotifsInRead != 0 || numMorifsInMate != 0)
     {
@@ -70,80 +96,74 @@ void AlignMatrix::add(const GraphAlignment& read, const GraphAlignment& mate)
     }
 }
 
-void AlignMatrix::add(const graphtools::GraphAlignment& graphAlign)
+void AlignMatrix::add(const AlignmentScoreSummary& alignmentSummary)
 {
-    vector<StrAlign> strAligns;
-    const int numMotifsInAlign = std::count(graphAlign.path().begin(), graphAlign.path().end(), strNode_);
-    StrAlign alignToMostConsistentAllele = alignmentCalculator_.findConsistentAlignment(numMotifsInAlign, graphAlign);
-
-    bestAlignsByRead_.push_back(alignToMostConsistentAllele);
+    // Every allele size below is evaluated in constant time from the same profile
+    const RepeatAlignmentProfile profile(strNode_, alignmentSummary);
+    const int numMotifsInAlign = profile.numMotifs();
+    const int offset = aligns_.size();
 
-    for (int numMotifs = numMotifsInAlign - 1; numMotifs != -1; --numMotifs)
+    for (int numMotifs = 0; numMotifs <= numMotifsInAlign; ++numMotifs)
     {
-        StrAlign align = alignmentCalculator_.findConsistentAlignment(numMotifs, graphAlign);
-        strAligns.emplace_back(align);
+        aligns_.push_back(alignmentCalculator_.findConsistentAlignment(numMotifs, profile));
     }
-    std::reverse(strAligns.begin(), strAligns.end());
-    strAligns.emplace_back(alignToMostConsistentAllele);
-    StrAlign previousAlign = strAligns.back();
+
     for (int numMotifs = numMotifsInAlign + 1;; ++numMotifs)
     {
-        StrAlign align = alignmentCalculator_.findConsistentAlignment(numMotifs, graphAlign);
+        const StrAlign align = alignmentCalculator_.findConsistentAlignment(numMotifs, profile);
+        const StrAlign& previousAlign = aligns_.back();
         if (align.type() == previousAlign.type() && align.score() == previousAlign.score())
         {
             break;
         }
-        strAligns.emplace_back(align);
-        previousAlign = align;
+        aligns_.push_back(align);
     }
 
-    alignScoreMatrix_.emplace_back(strAligns);
+    const int length = static_cast<int>(aligns_.size()) - offset;
+    rows_.push_back({ offset, length, numMotifsInAlign, false });
 }
 
 int AlignMatrix::getMaxMotifCount() const
 {
     int maxMotifCount = 0;
-    for (const auto& readAligns : alignScoreMatrix_)
+    for (const Row& row : rows_)
     {
-        const int maxMotifsInAlign = static_cast<int>(readAligns.size()) - 1;
-        if (maxMotifsInAlign > maxMotifCount)
+        if (!row.isRemoved)
         {
-            maxMotifCount = maxMotifsInAlign;
+            maxMotifCount = std::max(maxMotifCount, row.length - 1);
         }
     }
 
     return maxMotifCount;
 }
 
-StrAlign AlignMatrix::getBestAlign(int readIndex) const { return bestAlignsByRead_[readIndex]; }
-
 std::ostream& operator<<(std::ostream& out, const AlignMatrix& matrix)
 {
-    const auto& alignsByRead = matrix.matrix();
-
-    const unsigned alignCount(alignsByRead.size());
+    const unsigned alignCount(matrix.numReads());
     std::vector<unsigned> alignIndexes(alignCount);
     std::iota(alignIndexes.begin(), alignIndexes.end(), 0);
 
     // Sort alignIndexes to canonicalize the alignmatrix output
-    std::sort(alignIndexes.begin(), alignIndexes.end(), [&alignsByRead](const unsigned ai, const unsigned bi) -> bool {
-        const auto& a(alignsByRead[ai]);
-        const auto& b(alignsByRead[bi]);
-        if (a.size() < b.size())
+    std::sort(alignIndexes.begin(), alignIndexes.end(), [&matrix](const unsigned ai, const unsigned bi) -> bool {
+        const int aSize(matrix.getRowLength(ai));
+        const int bSize(matrix.getRowLength(bi));
+        if (aSize < bSize)
         {
             return true;
         }
-        if (b.size() < a.size())
+        if (bSize < aSize)
         {
             return false;
         }
-        for (unsigned i(0); i < a.size(); ++i)
+        for (int i(0); i < aSize; ++i)
         {
-            if (a[i] < b[i])
+            const StrAlign a(matrix.getAlign(ai, i));
+            const StrAlign b(matrix.getAlign(bi, i));
+            if (a < b)
             {
                 return true;
             }
-            if (b[i] < a[i])
+            if (b < a)
             {
                 return false;
             }
@@ -174,10 +194,9 @@ std::ostream& operator<<(std::ostream& out, const AlignMatrix& matrix)
     for (unsigned origAlignIndex(0); origAlignIndex < alignCount; ++origAlignIndex)
     {
         const unsigned alignIndex(alignIndexes[origAlignIndex]);
-        const auto& aligns(alignsByRead[alignIndex]);
-        for (const StrAlign& align : aligns)
+        for (int alleleSize(0); alleleSize < matrix.getRowLength(alignIndex); ++alleleSize)
         {
-            dumpStrAlign(align);
+            dumpStrAlign(matrix.getAlign(alignIndex, alleleSize));
         }
         out << "\n";
     }
@@ -188,15 +207,13 @@ std::ostream& operator<<(std::ostream& out, const AlignMatrix& matrix)
 void addIrrPairsIfPossibleExpansion(int maxMotifsInRead, AlignMatrix& alignMatrix, int numIrrPairs)
 {
     // Find highest-scoring in-repeat read
-    assert(alignMatrix.bestAlignsByRead_.size() == alignMatrix.alignScoreMatrix_.size());
-
     const int longIrrLowerBound = static_cast<int>(0.90 * maxMotifsInRead);
 
     int topIrrIndex = -1;
     int topIrrScore = -1;
     for (int readIndex = 0; readIndex != alignMatrix.numReads(); ++readIndex)
     {
-        const StrAlign& align = alignMatrix.bestAlignsByRead_[readIndex];
+        const StrAlign align = alignMatrix.getBestAlign(readIndex);
         const bool isLongIrr = align.type() == StrAlign::Type::kInRepeat && align.numMotifs() >= longIrrLowerBound;
 
         if (isLongIrr && align.score() > topIrrScore)
@@ -211,21 +228,33 @@ void addIrrPairsIfPossibleExpansion(int maxMotifsInRead, AlignMatrix& alignMatri
         return;
     }
 
-    StrAlign irrTopAlign = alignMatrix.bestAlignsByRead_[topIrrIndex];
-    vector<StrAlign> irrAligns = alignMatrix.alignScoreMatrix_[topIrrIndex];
+    // The new reads share the alignments of the top in-repeat read
+    const AlignMatrix::Row irrRow = alignMatrix.rows_[topIrrIndex];
+    alignMatrix.rows_.insert(alignMatrix.rows_.end(), 2 * numIrrPairs, irrRow);
+}
 
-    for (int newIrrIndex = 0; newIrrIndex != 2 * numIrrPairs; ++newIrrIndex)
+void AlignMatrix::remove(int readIndex)
+{
+    assert(readIndex < numReads());
+    Row& row = rows_[readIndex];
+    if (!row.isRemoved)
     {
-        alignMatrix.bestAlignsByRead_.push_back(irrTopAlign);
-        alignMatrix.alignScoreMatrix_.push_back(irrAligns);
+        row.isRemoved = true;
+        ++numRemovedRows_;
     }
 }
 
-void AlignMatrix::remove(int readIndex)
+// Alignments of the removed reads are left in the buffer since rows of duplicated reads may still refer to them
+void AlignMatrix::compact()
 {
-    assert(readIndex < numReads());
-    bestAlignsByRead_.erase(bestAlignsByRead_.begin() + readIndex);
-    alignScoreMatrix_.erase(alignScoreMatrix_.begin() + readIndex);
+    if (numRemovedRows_ == 0)
+    {
+        return;
+    }
+
+    rows_.erase(
+        std::remove_if(rows_.begin(), rows_.end(), [](const Row& row) { return row.isRemoved; }), rows_.end());
+    numRemovedRows_ = 0;
 }
 
 }
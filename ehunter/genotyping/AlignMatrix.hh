@@ -27,6 +27,7 @@
 
 #include "graphalign/GraphAlignment.hh"
 
+#include "alignment/AlignmentScoreSummary.hh"
 #include "genotyping/StrAlign.hh"
 
 namespace ehunter
@@ -34,26 +35,49 @@ namespace ehunter
 namespace strgt
 {
 
+/// Consistent alignments of each read to alleles of all sizes
+///
+/// Alignments of all reads are stored back to back in a single buffer. A row covers allele sizes up to the point
+/// where alignments to longer alleles stop changing; alignments to longer alleles are given by the last entry of the
+/// row. Duplicated rows refer to the same stretch of the buffer.
 class AlignMatrix
 {
 public:
     explicit AlignMatrix(int strNode);
-    int numReads() const { return alignScoreMatrix_.size(); }
+    int numReads() const { return rows_.size(); }
     void add(const graphtools::GraphAlignment& read, const graphtools::GraphAlignment& mate);
+    void add(const AlignmentScoreSummary& read, const AlignmentScoreSummary& mate);
+
+    // Marks the read for removal; indexes of the remaining reads stay valid until compact() is called
     void remove(int readIndex);
+    void compact();
+
     StrAlign getAlign(int readIndex, int alleleSize) const;
     StrAlign getBestAlign(int readIndex) const;
-    const std::vector<std::vector<StrAlign>>& matrix() const { return alignScoreMatrix_; }
+    int getRowLength(int readIndex) const;
+    // Collects alignments of all reads to the allele of the given size
+    void getAlignsToAllele(int alleleSize, std::vector<StrAlign>& aligns) const;
     int getMaxMotifCount() const;
 
     friend void addIrrPairsIfPossibleExpansion(int maxMotifsInRead, AlignMatrix& alignMatrix, int numIrrPairs);
 
 private:
-    void add(const graphtools::GraphAlignment& graphAlign);
+    struct Row
+    {
+        int offset;
+        int length;
+        int bestAlleleSize;
+        bool isRemoved;
+    };
+
+    void add(const AlignmentScoreSummary& alignmentSummary);
+    const Row& getRow(int readIndex) const;
+
     int strNode_;
     ConsistentAlignmentCalculator alignmentCalculator_;
-    std::vector<StrAlign> bestAlignsByRead_;
-    std::vector<std::vector<StrAlign>> alignScoreMatrix_;
+    std::vector<StrAlign> aligns_;
+    std::vector<Row> rows_;
+    int numRemovedRows_ = 0;
 };
 
 std::ostream& operator<<(std::ostream& out, const AlignMatrix& matrix);
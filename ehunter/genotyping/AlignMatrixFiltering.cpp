@@ -85,6 +85,8 @@ void filter(AlignMatrix& aligns)
             --readIndex;
         }
     }
+
+    aligns.compact();
 }
 
 CountTable countAligns(StrAlign::Type alignType, const AlignMatrix& aligns)
@@ -102,5 +104,30 @@ CountTable countAligns(StrAlign::Type alignType, const AlignMatrix& aligns)
     return countTable;
 }
 
+AlignCounts countAligns(const AlignMatrix& aligns)
+{
+    AlignCounts counts;
+    for (int readIndex = 0; readIndex != aligns.numReads(); ++readIndex)
+    {
+        const auto& align = aligns.getBestAlign(readIndex);
+        switch (align.type())
+        {
+        case StrAlign::Type::kSpanning:
+            counts.spanning.incrementCountOf(align.numMotifs());
+            break;
+        case StrAlign::Type::kFlanking:
+            counts.flanking.incrementCountOf(align.numMotifs());
+            break;
+        case StrAlign::Type::kInRepeat:
+            counts.inrepeat.incrementCountOf(align.numMotifs());
+            break;
+        default:
+            break;
+        }
+    }
+
+    return counts;
+}
+
 }
 }
\ No newline at end of file
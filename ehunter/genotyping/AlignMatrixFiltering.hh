@@ -33,5 +33,15 @@ void filter(AlignMatrix& aligns);
 
 CountTable countAligns(StrAlign::Type alignType, const AlignMatrix& aligns);
 
+struct AlignCounts
+{
+    CountTable spanning;
+    CountTable flanking;
+    CountTable inrepeat;
+};
+
+// Counts spanning, flanking, and in-repeat alignments in a single pass over the matrix
+AlignCounts countAligns(const AlignMatrix& aligns);
+
 }
 }
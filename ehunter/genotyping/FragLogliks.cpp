@@ -29,12 +29,12 @@
 #include <limits>
 #include <ostream>
 #include <sstream>
+#include <future>
 #include <stack>
 #include <utility>
 
 #include "spdlog/spdlog.h"
 
-using std::pair;
 using std::vector;
 
 namespace ehunter
@@ -42,24 +42,65 @@ namespace ehunter
 namespace strgt
 {
 
+namespace
+{
+// Read alignment likelihoods are modelled as 1.3^score scaled by 4^-readLength
+const double kLogAlignScoreBase = std::log(1.3);
+const double kLog2 = std::log(2.0);
+}
+
 double FragLogliks::getLoglik(int fragIndex, int alleleMotifCount)
 {
-    const FragIndexAndNumMotifs index = { fragIndex, alleleMotifCount };
-    auto queryResult = fragLogliksBySize_.find(index);
-    if (queryResult != fragLogliksBySize_.end())
+    assert(fragIndex < numFrags());
+    return getLogliks(alleleMotifCount)[fragIndex];
+}
+
+const vector<double>& FragLogliks::getLogliks(int alleleMotifCount)
+{
+    std::lock_guard<std::mutex> lock(fragLogliksMutex_);
+    auto queryResult = fragLogliksByAlleleSize_.find(alleleMotifCount);
+    if (queryResult != fragLogliksByAlleleSize_.end())
     {
         return queryResult->second;
     }
 
-    int readIndex = 2 * fragIndex;
-    int mateIndex = readIndex + 1;
-    assert(mateIndex < alignMatrix_.numReads());
-    const auto& readAlign = alignMatrix_.getAlign(readIndex, alleleMotifCount);
-    const auto& mateAlign = alignMatrix_.getAlign(mateIndex, alleleMotifCount);
+    vector<double>& fragLogliks = fragLogliksByAlleleSize_[alleleMotifCount];
+    computeLogliks(alleleMotifCount, fragLogliks);
+    return fragLogliks;
+}
 
-    const double loglik = computeLoglik(readAlign, mateAlign, alleleMotifCount);
-    fragLogliksBySize_[index] = loglik;
-    return loglik;
+void FragLogliks::computeLogliks(int alleleMotifCount, vector<double>& fragLogliks)
+{
+    alignMatrix_.getAlignsToAllele(alleleMotifCount, alignsToAllele_);
+    fragLogliks.resize(numFrags());
+
+    // Each thread fills its own block of fragments
+    const int numFragsPerThread = (numFrags() + threadCount_ - 1) / threadCount_;
+    vector<std::future<void>> blockResults;
+    for (int firstFragIndex = numFragsPerThread; firstFragIndex < numFrags(); firstFragIndex += numFragsPerThread)
+    {
+        const int lastFragIndex = std::min(firstFragIndex + numFragsPerThread, numFrags());
+        blockResults.push_back(std::async(std::launch::async, [=, &fragLogliks]() {
+            computeLogliks(alleleMotifCount, firstFragIndex, lastFragIndex, fragLogliks);
+        }));
+    }
+
+    computeLogliks(alleleMotifCount, 0, std::min(numFragsPerThread, numFrags()), fragLogliks);
+    for (auto& blockResult : blockResults)
+    {
+        blockResult.get();
+    }
+}
+
+void FragLogliks::computeLogliks(
+    int alleleMotifCount, int firstFragIndex, int lastFragIndex, vector<double>& fragLogliks)
+{
+    for (int fragIndex = firstFragIndex; fragIndex != lastFragIndex; ++fragIndex)
+    {
+        const StrAlign& readAlign = alignsToAllele_[2 * fragIndex];
+        const StrAlign& mateAlign = alignsToAllele_[2 * fragIndex + 1];
+        fragLogliks[fragIndex] = computeLoglik(readAlign, mateAlign, alleleMotifCount);
+    }
 }
 
 double FragLogliks::computeLoglik(const StrAlign& readAlign, const StrAlign& mateAlign, int alleleMotifCount) const
@@ -91,8 +132,8 @@ double FragLogliks::computeLoglik(const StrAlign& readAlign, const StrAlign& mat
         }
     }
 
-    const double readAlignLoglik = readAlign.score() * std::log(1.3) - 2 * readLen_ * std::log(2.0);
-    const double mateAlignLoglik = mateAlign.score() * std::log(1.3) - 2 * readLen_ * std::log(2.0);
+    const double readAlignLoglik = readAlign.score() * kLogAlignScoreBase - 2 * readLen_ * kLog2;
+    const double mateAlignLoglik = mateAlign.score() * kLogAlignScoreBase - 2 * readLen_ * kLog2;
     return std::log(numOriginsForThisFrag) - std::log(numPossibleOrigins) + readAlignLoglik + mateAlignLoglik;
 }
 
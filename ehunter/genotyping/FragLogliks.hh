@@ -23,8 +23,9 @@
 
 #pragma once
 
+#include <cmath>
+#include <mutex>
 #include <unordered_map>
-#include <utility>
 #include <vector>
 
 #include "genotyping/AlignMatrix.hh"
@@ -34,31 +35,53 @@ namespace ehunter
 namespace strgt
 {
 
+/// Prior probability that a fragment is mismapped to the locus, and the log priors of mismapped and correctly mapped
+/// fragments used by the genotypers
+const double kMismapProb = 0.001;
+const double kLogMismapPrior = std::log(kMismapProb);
+const double kLogRightmapPrior = std::log(1.0 - kMismapProb);
+
+/// Log-likelihoods of fragments given alleles of various sizes
+///
+/// Log-likelihoods of all fragments given an allele of a particular size are computed together the first time that
+/// allele size is requested and stored contiguously, so genotype likelihoods reduce to sweeps over these columns.
+/// Log-likelihoods can be requested from several threads at once. Loci with at least kMinFragsForParallelGenotyping
+/// fragments split the computation of each column over up to threadCount threads.
 class FragLogliks
 {
 public:
-    FragLogliks(int motifLen, int readLen, int fragLen, const AlignMatrix* alignMatrixPtr)
+    static const int kMinFragsForParallelGenotyping = 5000;
+
+    FragLogliks(int motifLen, int readLen, int fragLen, const AlignMatrix* alignMatrixPtr, int threadCount = 1)
         : motifLen_(motifLen)
         , readLen_(readLen)
         , fragLen_(fragLen)
         , alignMatrix_(*alignMatrixPtr)
+        , threadCount_(numFrags() < kMinFragsForParallelGenotyping ? 1 : std::max(threadCount, 1))
     {
         assert(alignMatrix_.numReads() % 2 == 0);
     }
     int numFrags() const { return alignMatrix_.numReads() / 2; }
+    // Number of threads that genotyping computations over these fragments may use
+    int threadCount() const { return threadCount_; }
     double getLoglik(int fragIndex, int alleleMotifCount);
 
-private:
-    using FragIndex = int;
-    using FragIndexAndNumMotifs = std::pair<FragIndex, int>;
+    // Log-likelihoods of all fragments given the allele; references stay valid for the lifetime of this object
+    const std::vector<double>& getLogliks(int alleleMotifCount);
 
+private:
+    void computeLogliks(int alleleMotifCount, std::vector<double>& fragLogliks);
+    void computeLogliks(int alleleMotifCount, int firstFragIndex, int lastFragIndex, std::vector<double>& fragLogliks);
     double computeLoglik(const StrAlign& readAlign, const StrAlign& mateAlign, int alleleMotifCount) const;
 
     int motifLen_;
     int readLen_;
     int fragLen_;
     const AlignMatrix& alignMatrix_;
-    std::unordered_map<FragIndexAndNumMotifs, double> fragLogliksBySize_;
+    int threadCount_;
+    std::mutex fragLogliksMutex_;
+    std::vector<StrAlign> alignsToAllele_;
+    std::unordered_map<int, std::vector<double>> fragLogliksByAlleleSize_;
 };
 
 }
@@ -28,7 +28,7 @@
 
 #include "core/LogSum.hh"
 
-using std::unordered_set;
+using std::vector;
 
 namespace ehunter
 {
@@ -125,7 +125,7 @@ static Ci getCiAlongX(int& bestX, OneAlleleGenotyper* genotyper, LikelihoodFn li
     return { ciCandidate.startSize, ciCandidate.endSize };
 }
 
-RepeatGenotype OneAlleleGenotyper::genotype(const unordered_set<int>& alleleSizeCandidates)
+RepeatGenotype OneAlleleGenotyper::genotype(const vector<int>& alleleSizeCandidates)
 {
     RepeatGenotype gt = getMostLikelyGenotype(alleleSizeCandidates);
     int bestSize = gt.shortAlleleSizeInUnits();
@@ -137,7 +137,7 @@ RepeatGenotype OneAlleleGenotyper::genotype(const unordered_set<int>& alleleSize
     return gt;
 }
 
-RepeatGenotype OneAlleleGenotyper::getMostLikelyGenotype(const unordered_set<int>& alleleSizeCandidates)
+RepeatGenotype OneAlleleGenotyper::getMostLikelyGenotype(const vector<int>& alleleSizeCandidates)
 {
     double maxGtLoglik = std::numeric_limits<double>::lowest();
     int bestMotifCount = 0;
@@ -163,19 +163,17 @@ double OneAlleleGenotyper::getAlleleLoglik(int motifCount)
         return std::numeric_limits<double>::lowest();
     }
 
-    double genotypeLoglik = 0;
+    const std::vector<double>& fragLogliks = fragLogliks_.getLogliks(motifCount);
+    return sumLogSums(mismapTerms_.data(), fragLogliks.data(), kLogRightmapPrior, fragLogliks_.numFrags());
+}
 
-    for (int fragIndex = 0; fragIndex != fragLogliks_.numFrags(); ++fragIndex)
+void OneAlleleGenotyper::initializeMismapTerms(const std::vector<double>& topFragLogliks)
+{
+    mismapTerms_.reserve(topFragLogliks.size());
+    for (const double loglikGivenMismap : topFragLogliks)
     {
-        const double fragLoglik = fragLogliks_.getLoglik(fragIndex, motifCount);
-        const double loglikGivenRightmap = fragLoglik;
-        const double loglikGivenMismap = topFragLogliks_[fragIndex];
-        const double mismapPrior = std::log(0.001);
-        const double rightmapPrior = std::log(1.0 - 0.001);
-        genotypeLoglik += getLogSum(mismapPrior + loglikGivenMismap, rightmapPrior + loglikGivenRightmap);
+        mismapTerms_.push_back(kLogMismapPrior + loglikGivenMismap);
     }
-
-    return genotypeLoglik;
 }
 
 }
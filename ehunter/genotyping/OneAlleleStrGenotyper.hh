@@ -23,7 +23,8 @@
 
 #pragma once
 
-#include <unordered_set>
+
+#include <vector>
 
 #include "genotyping/AlignMatrix.hh"
 #include "genotyping/FragLogliks.hh"
@@ -39,20 +40,22 @@ class OneAlleleGenotyper
 public:
     OneAlleleGenotyper(int motifLen, std::vector<double> topFragLogliks, FragLogliks* fragLogliksPtr)
         : motifLen_(motifLen)
-        , topFragLogliks_(std::move(topFragLogliks))
         , fragLogliks_(*fragLogliksPtr)
     {
+        initializeMismapTerms(topFragLogliks);
     }
 
-    RepeatGenotype genotype(const std::unordered_set<int>& alleleSizeCandidates);
+    RepeatGenotype genotype(const std::vector<int>& alleleSizeCandidates);
 
 private:
-    RepeatGenotype getMostLikelyGenotype(const std::unordered_set<int>& alleleSizeCandidates);
+    RepeatGenotype getMostLikelyGenotype(const std::vector<int>& alleleSizeCandidates);
     double getAlleleLoglik(int motifCount);
+    void initializeMismapTerms(const std::vector<double>& topFragLogliks);
 
     int motifLen_;
-    std::vector<double> topFragLogliks_;
     FragLogliks& fragLogliks_;
+    // Log-likelihoods of the fragments given that they are mismapped, weighted by the mismapping prior
+    std::vector<double> mismapTerms_;
 };
 
 }
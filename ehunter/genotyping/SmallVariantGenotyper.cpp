@@ -21,16 +21,20 @@
 //
 
 #include "genotyping/SmallVariantGenotyper.hh"
-#include <boost/math/distributions/poisson.hpp>
 #include <numeric>
 
 using boost::optional;
-using boost::math::poisson_distribution;
 using std::vector;
 
 namespace ehunter
 {
 
+namespace
+{
+// Log of the Poisson probability of the count without the -log(count!) term
+double logPoissonKernel(int count, double mean, double logMean) { return count * logMean - mean; }
+}
+
 boost::optional<SmallVariantGenotype> SmallVariantGenotyper::genotype(int refCount, int altCount) const
 {
     if (expectedAlleleCount_ > 2)
@@ -44,7 +48,7 @@ boost::optional<SmallVariantGenotype> SmallVariantGenotyper::genotype(int refCou
         throw std::runtime_error("Invalid read counts: " + std::to_string(refCount) + " " + std::to_string(altCount));
     }
 
-    auto possibleGenotypes = getPossibleGenotypes(expectedAlleleCount_);
+    const auto& possibleGenotypes = getPossibleGenotypes(expectedAlleleCount_);
 
     const int totalReadCount = refCount + altCount;
     if (totalReadCount == 0) // missing genotype
@@ -52,6 +56,11 @@ boost::optional<SmallVariantGenotype> SmallVariantGenotyper::genotype(int refCou
         return {};
     }
 
+    if (!(haplotypeDepth_ > 0))
+    {
+        throw std::runtime_error("Invalid haplotype depth: " + std::to_string(haplotypeDepth_));
+    }
+
     const unsigned genotypeCount(possibleGenotypes.size());
     if (genotypeCount == 0)
     {
@@ -73,17 +82,20 @@ boost::optional<SmallVariantGenotype> SmallVariantGenotyper::genotype(int refCou
     return possibleGenotypes[mostLikelyGenotypeIndex];
 }
 
-vector<SmallVariantGenotype> SmallVariantGenotyper::getPossibleGenotypes(int numAlleles) const
+const vector<SmallVariantGenotype>& SmallVariantGenotyper::getPossibleGenotypes(int numAlleles) const
 {
+    static const vector<SmallVariantGenotype> haploidGenotypes = { AlleleType::kRef, AlleleType::kAlt };
+    static const vector<SmallVariantGenotype> diploidGenotypes = { { AlleleType::kRef, AlleleType::kRef },
+                                                                   { AlleleType::kRef, AlleleType::kAlt },
+                                                                   { AlleleType::kAlt, AlleleType::kAlt } };
+
     if (numAlleles == 1)
     {
-        return { AlleleType::kRef, AlleleType::kAlt };
+        return haploidGenotypes;
     }
     else if (numAlleles == 2)
     {
-        return { { AlleleType::kRef, AlleleType::kRef },
-                 { AlleleType::kRef, AlleleType::kAlt },
-                 { AlleleType::kAlt, AlleleType::kAlt } };
+        return diploidGenotypes;
     }
     else
     {
@@ -94,22 +106,15 @@ vector<SmallVariantGenotype> SmallVariantGenotyper::getPossibleGenotypes(int num
 double
 SmallVariantGenotyper::genotypeLikelihood(const SmallVariantGenotype& currentGenotype, int refCount, int altCount) const
 {
-    const poisson_distribution<> errorDistribution(errorRate_);
-
     const bool isHomozygous = currentGenotype.isHomRef() || currentGenotype.isHomAlt();
-    const int copyNumberOfExistingAllele = isHomozygous ? 2 : 1;
-    const poisson_distribution<> countDistribution(copyNumberOfExistingAllele * haplotypeDepth_);
-
-    double genotypeLikelihood
-        = currentGenotype.isHomRef() ? log(pdf(errorDistribution, altCount)) : log(pdf(countDistribution, altCount));
+    const double countMean = isHomozygous ? 2 * haplotypeDepth_ : haplotypeDepth_;
+    const double logCountMean = isHomozygous ? logTwoCopyDepth_ : logHaplotypeDepth_;
 
-    genotypeLikelihood
-        += currentGenotype.isHomAlt() ? log(pdf(errorDistribution, refCount)) : log(pdf(countDistribution, refCount));
+    double genotypeLikelihood = currentGenotype.isHomRef() ? logPoissonKernel(altCount, errorRate_, logErrorRate_)
+                                                           : logPoissonKernel(altCount, countMean, logCountMean);
 
-    if (std::isinf(genotypeLikelihood))
-    {
-        genotypeLikelihood = -std::numeric_limits<double>::max();
-    }
+    genotypeLikelihood += currentGenotype.isHomAlt() ? logPoissonKernel(refCount, errorRate_, logErrorRate_)
+                                                     : logPoissonKernel(refCount, countMean, logCountMean);
 
     return genotypeLikelihood;
 }
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <cmath>
 #include <vector>
 
 #include "core/Common.hh"
@@ -37,6 +38,9 @@ public:
     SmallVariantGenotyper(double haplotypeDepth, AlleleCount expectedAlleleCount)
         : haplotypeDepth_(haplotypeDepth)
         , expectedAlleleCount_((int)expectedAlleleCount)
+        , logErrorRate_(std::log(errorRate_))
+        , logHaplotypeDepth_(std::log(haplotypeDepth))
+        , logTwoCopyDepth_(std::log(2 * haplotypeDepth))
     {
     }
 
@@ -49,10 +53,13 @@ private:
     /**
      * return a vector of all possible genotypes given the number alleles
      */
-    std::vector<SmallVariantGenotype> getPossibleGenotypes(int numAlleles) const;
+    const std::vector<SmallVariantGenotype>& getPossibleGenotypes(int numAlleles) const;
 
     /**
-     * return genotype likelihood of the given genotype
+     * return genotype log-likelihood of the given genotype, up to the terms shared by all genotypes
+     *
+     * Counts are Poisson distributed, so the log-likelihood is evaluated in closed form from the precomputed logs of
+     * the Poisson means; the log(count!) terms are the same for all genotypes and are left out
      * @param currentGenotyper the given genotype
      * @param readCounts Read count vector for each allele (in order)
      */
@@ -72,6 +79,13 @@ private:
      * hard-coded parameters
      */
     double errorRate_ = 0.05;
+
+    /**
+     * logs of the expected counts from errors, one copy and two copies of an allele
+     */
+    double logErrorRate_;
+    double logHaplotypeDepth_;
+    double logTwoCopyDepth_;
 };
 
 }
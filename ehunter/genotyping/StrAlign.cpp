@@ -27,12 +27,7 @@
 
 #include "spdlog/spdlog.h"
 
-#include "graphalign/LinearAlignment.hh"
-
-using graphtools::Alignment;
 using graphtools::GraphAlignment;
-using graphtools::Operation;
-using graphtools::OperationType;
 
 namespace ehunter
 {
@@ -67,73 +62,56 @@ std::ostream& operator<<(std::ostream& out, const StrAlign& summary)
     return out;
 }
 
-void scoreAlignment(
-    const Alignment& alignment, int matchScore, int mismatchScore, int gapScore, int& score, int& indelCount)
+RepeatAlignmentProfile::RepeatAlignmentProfile(int strNodeId, const AlignmentScoreSummary& alignmentSummary)
+    : alignment_(&alignmentSummary.alignment())
+    , motifLength_(alignmentSummary.alignment().path().graphRawPtr()->nodeSeq(strNodeId).length())
 {
-    score = 0;
-    indelCount = 0;
-
-    for (const Operation& operation : alignment)
-    {
-        switch (operation.type())
-        {
-        case OperationType::kMatch:
-            score += matchScore * static_cast<int>(operation.referenceLength());
-            break;
-        case OperationType::kMismatch:
-            score += mismatchScore * static_cast<int>(operation.referenceLength());
-            break;
-        case OperationType::kInsertionToRef:
-            score += gapScore * static_cast<int>(operation.queryLength());
-            indelCount += operation.queryLength();
-            break;
-        case OperationType::kDeletionFromRef:
-            score += gapScore * static_cast<int>(operation.referenceLength());
-            indelCount += operation.referenceLength();
-            break;
-        default:
-            break;
-        }
-    }
-}
+    motifScorePrefixSums_.reserve(alignmentSummary.countOccurrencesOfNode(strNodeId) + 1);
+    motifIndelPrefixSums_.reserve(alignmentSummary.countOccurrencesOfNode(strNodeId) + 1);
+    motifScorePrefixSums_.push_back(0);
+    motifIndelPrefixSums_.push_back(0);
 
-StrAlign ConsistentAlignmentCalculator::clipFromLeft(int numMotifsInAllele, const GraphAlignment& alignment) const
-{
-    int leftFlankScore = 0, strScore = 0, rightFlankScore = 0;
-    int strIndelCount = 0;
-    int numMotifsInAlignment = std::count(alignment.path().begin(), alignment.path().end(), strNodeId_);
-    int numMotifsLeft = numMotifsInAlignment;
-    for (int nodeIndex = 0; nodeIndex != static_cast<int>(alignment.size()); ++nodeIndex)
+    for (int nodeIndex = 0; nodeIndex != alignmentSummary.numNodes(); ++nodeIndex)
     {
-        int node = alignment.getNodeIdByIndex(nodeIndex);
-        const auto& nodeAlign = alignment.alignments()[nodeIndex];
-        int nodeScore = 0;
-        int nodeIndelCount = 0;
-        scoreAlignment(nodeAlign, matchScore_, mismatchScore_, gapOpenScore_, nodeScore, nodeIndelCount);
+        const int node = alignmentSummary.getNodeIdByIndex(nodeIndex);
+        const int nodeScore = alignmentSummary.getNodeScore(nodeIndex);
 
-        if (node < strNodeId_)
-        {
-            leftFlankScore += nodeScore;
-        }
-        else if (strNodeId_ < node)
+        if (node < strNodeId)
         {
-            rightFlankScore += nodeScore;
+            leftFlankScore_ += nodeScore;
         }
-        else if (numMotifsLeft <= numMotifsInAllele)
+        else if (strNodeId < node)
         {
-            strScore += nodeScore;
-            strIndelCount += nodeIndelCount;
-            --numMotifsLeft;
+            rightFlankScore_ += nodeScore;
         }
         else
         {
-            --numMotifsLeft;
+            motifScorePrefixSums_.push_back(motifScorePrefixSums_.back() + nodeScore);
+            motifIndelPrefixSums_.push_back(
+                motifIndelPrefixSums_.back() + alignmentSummary.getNodeIndelCount(nodeIndex));
         }
     }
 
-    // Zero out negative scores
-    leftFlankScore = std::max(leftFlankScore, 0);
-    rightFlankScore = std::max(rightFlankScore, 0);
+    leftFlankScore_ = std::max(leftFlankScore_, 0);
+    rightFlankScore_ = std::max(rightFlankScore_, 0);
+}
+
+StrAlign ConsistentAlignmentCalculator::clipFromLeft(int numMotifsInAllele, const GraphAlignment& alignment) const
+{
+    return clipFromLeft(numMotifsInAllele, RepeatAlignmentProfile(strNodeId_, AlignmentScoreSummary(alignment)));
+}
+
+StrAlign
+ConsistentAlignmentCalculator::clipFromLeft(int numMotifsInAllele, const RepeatAlignmentProfile& profile) const
+{
+    const int leftFlankScore = profile.leftFlankScore();
+    const int rightFlankScore = profile.rightFlankScore();
+    const int numMotifsInAlignment = profile.numMotifs();
+
+    // Clipping from the left keeps the last motifs of the alignment
+    const int numCompatibleMotifs = std::min(numMotifsInAlignment, numMotifsInAllele);
+    const int strScore = profile.scoreLastMotifs(numCompatibleMotifs);
+    const int strIndelCount = profile.countIndelsInLastMotifs(numCompatibleMotifs);
 
     // Alignment does not overlap the repeat
     if (numMotifsInAlignment == 0 && (leftFlankScore == 0 || rightFlankScore == 0))
@@ -141,8 +119,6 @@ StrAlign ConsistentAlignmentCalculator::clipFromLeft(int numMotifsInAllele, cons
         return { StrAlign::Type::kOutside, 0, leftFlankScore + rightFlankScore, 0 };
     }
 
-    const int numCompatibleMotifs = std::min(numMotifsInAlignment, numMotifsInAllele);
-
     // Original alignment is in-repeat
     if (leftFlankScore == 0 && rightFlankScore == 0)
     {
@@ -183,7 +159,7 @@ StrAlign ConsistentAlignmentCalculator::clipFromLeft(int numMotifsInAllele, cons
     }
 
     std::ostringstream out;
-    out << "Cannot summarize " << alignment << " clipped from left for STR on node " << strNodeId_;
+    out << "Cannot summarize " << profile.alignment() << " clipped from left for STR on node " << strNodeId_;
     spdlog::warn(out.str());
 
     return { StrAlign::Type::kOutside, 0, 0, 0 };
@@ -192,46 +168,21 @@ StrAlign ConsistentAlignmentCalculator::clipFromLeft(int numMotifsInAllele, cons
 StrAlign
 ConsistentAlignmentCalculator::clipFromRight(int numMotifsInAllele, const graphtools::GraphAlignment& alignment) const
 {
-    int leftFlankScore = 0, strScore = 0, rightFlankScore = 0;
-    int strIndelCount = 0;
-
-    int motifIndex = 0;
-    for (int nodeIndex = 0; nodeIndex != static_cast<int>(alignment.size()); ++nodeIndex)
-    {
-        int node = alignment.getNodeIdByIndex(nodeIndex);
-        const auto& nodeAlign = alignment.alignments()[nodeIndex];
-
-        int nodeScore = 0;
-        int nodeIndelCount = 0;
-        scoreAlignment(nodeAlign, matchScore_, mismatchScore_, gapOpenScore_, nodeScore, nodeIndelCount);
+    return clipFromRight(numMotifsInAllele, RepeatAlignmentProfile(strNodeId_, AlignmentScoreSummary(alignment)));
+}
 
-        if (node < strNodeId_)
-        {
-            leftFlankScore += nodeScore;
-        }
-        else if (strNodeId_ < node)
-        {
-            rightFlankScore += nodeScore;
-        }
-        else if (motifIndex + 1 <= numMotifsInAllele)
-        {
-            assert(node == strNodeId_);
-            strScore += nodeScore;
-            strIndelCount += nodeIndelCount;
-            ++motifIndex;
-        }
-        else
-        {
-            assert(node == strNodeId_);
-            ++motifIndex;
-        }
-    }
+StrAlign
+ConsistentAlignmentCalculator::clipFromRight(int numMotifsInAllele, const RepeatAlignmentProfile& profile) const
+{
+    const int leftFlankScore = profile.leftFlankScore();
+    const int rightFlankScore = profile.rightFlankScore();
+    const int numMotifsInAlignment = profile.numMotifs();
 
-    // Zero out negative scores
-    leftFlankScore = std::max(leftFlankScore, 0);
-    rightFlankScore = std::max(rightFlankScore, 0);
+    // Clipping from the right keeps the first motifs of the alignment
+    const int numCompatibleMotifs = std::min(numMotifsInAlignment, numMotifsInAllele);
+    const int strScore = profile.scoreFirstMotifs(numCompatibleMotifs);
+    const int strIndelCount = profile.countIndelsInFirstMotifs(numCompatibleMotifs);
 
-    int numMotifsInAlignment = std::count(alignment.path().begin(), alignment.path().end(), strNodeId_);
     // Alignment does not overlap the repeat
     if (numMotifsInAlignment == 0 && (leftFlankScore == 0 || rightFlankScore == 0))
     {
@@ -239,8 +190,6 @@ ConsistentAlignmentCalculator::clipFromRight(int numMotifsInAllele, const grapht
         return { StrAlign::Type::kOutside, 0, score, 0 };
     }
 
-    const int numCompatibleMotifs = std::min(numMotifsInAlignment, numMotifsInAllele);
-
     // Original alignment is in-repeat
     if (leftFlankScore == 0 && rightFlankScore == 0)
     {
@@ -284,7 +233,7 @@ ConsistentAlignmentCalculator::clipFromRight(int numMotifsInAllele, const grapht
     }
 
     std::ostringstream out;
-    out << "Cannot summarize " << alignment << " clipped from right for STR on node " << strNodeId_;
+    out << "Cannot summarize " << profile.alignment() << " clipped from right for STR on node " << strNodeId_;
     spdlog::warn(out.str());
 
     return { StrAlign::Type::kOutside, 0, 0, 0 };
@@ -292,50 +241,27 @@ ConsistentAlignmentCalculator::clipFromRight(int numMotifsInAllele, const grapht
 
 StrAlign ConsistentAlignmentCalculator::removeStutter(int numMotifsInAllele, const GraphAlignment& alignment) const
 {
-    int leftFlankScore = 0, strScore = 0, rightFlankScore = 0;
-    int strIndelCount = 0;
-    int motifIndex = 0;
-    for (int nodeIndex = 0; nodeIndex != static_cast<int>(alignment.size()); ++nodeIndex)
-    {
-        int node = alignment.getNodeIdByIndex(nodeIndex);
-        const auto& nodeAlign = alignment.alignments()[nodeIndex];
-        int nodeScore = 0;
-        int nodeIndelCount = 0;
-        scoreAlignment(nodeAlign, matchScore_, mismatchScore_, gapOpenScore_, nodeScore, nodeIndelCount);
-
-        if (node < strNodeId_)
-        {
-            leftFlankScore += nodeScore;
-        }
-        else if (strNodeId_ < node)
-        {
-            rightFlankScore += nodeScore;
-        }
-        else if (motifIndex + 1 <= numMotifsInAllele)
-        {
-            strScore += nodeScore;
-            strIndelCount += nodeIndelCount;
-            ++motifIndex;
-        }
-        else
-        {
-            ++motifIndex;
-        }
-    }
+    return removeStutter(numMotifsInAllele, RepeatAlignmentProfile(strNodeId_, AlignmentScoreSummary(alignment)));
+}
 
-    // Zero out negative scores
-    leftFlankScore = std::max(leftFlankScore, 0);
-    rightFlankScore = std::max(rightFlankScore, 0);
+StrAlign
+ConsistentAlignmentCalculator::removeStutter(int numMotifsInAllele, const RepeatAlignmentProfile& profile) const
+{
+    const int leftFlankScore = profile.leftFlankScore();
+    const int rightFlankScore = profile.rightFlankScore();
 
     if (leftFlankScore == 0 || rightFlankScore == 0)
     {
         return { StrAlign::Type::kOutside, 0, 0, 0 };
     }
 
-    const int numMotifsInAlignment = std::count(alignment.path().begin(), alignment.path().end(), strNodeId_);
+    const int numMotifsInAlignment = profile.numMotifs();
+    const int numCompatibleMotifs = std::min(numMotifsInAlignment, numMotifsInAllele);
+    const int strScore = profile.scoreFirstMotifs(numCompatibleMotifs);
+    const int strIndelCount = profile.countIndelsInFirstMotifs(numCompatibleMotifs);
+
     const int numDiscrepantMotifs = std::abs(numMotifsInAlignment - numMotifsInAllele);
-    const int motifLength = alignment.path().graphRawPtr()->nodeSeq(strNodeId_).length();
-    const int discrepantLength = motifLength * numDiscrepantMotifs;
+    const int discrepantLength = profile.motifLength() * numDiscrepantMotifs;
     const int gapOpenScore = -24;
     const int gapExtendScore = -12;
     int penaltyScore = numDiscrepantMotifs > 0 ? gapOpenScore + gapExtendScore * (discrepantLength - 1) : 0;
@@ -347,9 +273,16 @@ StrAlign ConsistentAlignmentCalculator::removeStutter(int numMotifsInAllele, con
 StrAlign
 ConsistentAlignmentCalculator::findConsistentAlignment(int numMotifsInAllele, const GraphAlignment& alignment) const
 {
-    StrAlign stutterFreeAlign = removeStutter(numMotifsInAllele, alignment);
-    StrAlign leftClipAlign = clipFromLeft(numMotifsInAllele, alignment);
-    StrAlign rightClipAlign = clipFromRight(numMotifsInAllele, alignment);
+    return findConsistentAlignment(
+        numMotifsInAllele, RepeatAlignmentProfile(strNodeId_, AlignmentScoreSummary(alignment)));
+}
+
+StrAlign ConsistentAlignmentCalculator::findConsistentAlignment(
+    int numMotifsInAllele, const RepeatAlignmentProfile& profile) const
+{
+    StrAlign stutterFreeAlign = removeStutter(numMotifsInAllele, profile);
+    StrAlign leftClipAlign = clipFromLeft(numMotifsInAllele, profile);
+    StrAlign rightClipAlign = clipFromRight(numMotifsInAllele, profile);
 
     if (stutterFreeAlign.score() > leftClipAlign.score() && stutterFreeAlign.score() > rightClipAlign.score())
     {
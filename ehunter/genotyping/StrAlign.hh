@@ -22,9 +22,12 @@
 #include <cassert>
 #include <limits>
 #include <ostream>
+#include <vector>
 
 #include "graphalign/GraphAlignment.hh"
 
+#include "alignment/AlignmentScoreSummary.hh"
+
 namespace ehunter
 {
 
@@ -120,6 +123,44 @@ private:
 std::ostream& operator<<(std::ostream& out, StrAlign::Type type);
 std::ostream& operator<<(std::ostream& out, const StrAlign& summary);
 
+/// Scores of the parts of an alignment that consistent alignments are assembled from
+///
+/// Scores and indel counts of the motifs are accumulated along the alignment path, so any number of leading or
+/// trailing motifs is scored in constant time. Consistent alignments to alleles of all sizes thus take a single pass
+/// over the alignment.
+class RepeatAlignmentProfile
+{
+public:
+    RepeatAlignmentProfile(int strNodeId, const AlignmentScoreSummary& alignmentSummary);
+
+    const graphtools::GraphAlignment& alignment() const { return *alignment_; }
+    int motifLength() const { return motifLength_; }
+    int numMotifs() const { return static_cast<int>(motifScorePrefixSums_.size()) - 1; }
+
+    // Negative flank scores are zeroed out
+    int leftFlankScore() const { return leftFlankScore_; }
+    int rightFlankScore() const { return rightFlankScore_; }
+
+    int scoreFirstMotifs(int numMotifs) const { return motifScorePrefixSums_[numMotifs]; }
+    int scoreLastMotifs(int numMotifs) const
+    {
+        return motifScorePrefixSums_.back() - motifScorePrefixSums_[this->numMotifs() - numMotifs];
+    }
+    int countIndelsInFirstMotifs(int numMotifs) const { return motifIndelPrefixSums_[numMotifs]; }
+    int countIndelsInLastMotifs(int numMotifs) const
+    {
+        return motifIndelPrefixSums_.back() - motifIndelPrefixSums_[this->numMotifs() - numMotifs];
+    }
+
+private:
+    const graphtools::GraphAlignment* alignment_;
+    int motifLength_;
+    int leftFlankScore_ = 0;
+    int rightFlankScore_ = 0;
+    std::vector<int> motifScorePrefixSums_;
+    std::vector<int> motifIndelPrefixSums_;
+};
+
 class ConsistentAlignmentCalculator
 {
 public:
@@ -130,20 +171,23 @@ public:
 
     int strNodeId() const { return strNodeId_; }
 
+    // Overloads that take an alignment profile it on each call; callers that evaluate an alignment against many
+    // alleles should create its RepeatAlignmentProfile once instead
+
     // Calculates longest consistent alignment by clipping from left (right)
     StrAlign clipFromLeft(int numMotifsInAllele, const graphtools::GraphAlignment& alignment) const;
     StrAlign clipFromRight(int numMotifsInAllele, const graphtools::GraphAlignment& alignment) const;
+    StrAlign clipFromLeft(int numMotifsInAllele, const RepeatAlignmentProfile& profile) const;
+    StrAlign clipFromRight(int numMotifsInAllele, const RepeatAlignmentProfile& profile) const;
 
     // Calculates consistent alignment by removing PCR stutter
     StrAlign removeStutter(int numMotifsInAllele, const graphtools::GraphAlignment& alignment) const;
+    StrAlign removeStutter(int numMotifsInAllele, const RepeatAlignmentProfile& profile) const;
 
     StrAlign findConsistentAlignment(int numMotifsInAllele, const graphtools::GraphAlignment& alignment) const;
+    StrAlign findConsistentAlignment(int numMotifsInAllele, const RepeatAlignmentProfile& profile) const;
 
 private:
-    int matchScore_ = 5;
-    int mismatchScore_ = -4;
-    int gapOpenScore_ = -8;
-
     int strNodeId_;
 };
 
@@ -21,13 +21,13 @@
 
 #include "genotyping/StrGenotyper.hh"
 
+#include <algorithm>
 #include <vector>
 
 #include "genotyping/AlignMatrixFiltering.hh"
 #include "genotyping/OneAlleleStrGenotyper.hh"
 #include "genotyping/TwoAlleleStrGenotyper.hh"
 
-using std::unordered_set;
 using std::vector;
 
 namespace ehunter
@@ -35,9 +35,9 @@ namespace ehunter
 namespace strgt
 {
 
-unordered_set<int> getAlleleCandidates(int readLen, int motifLen, const AlignMatrix& alignMatrix)
+vector<int> getAlleleCandidates(int readLen, int motifLen, const AlignMatrix& alignMatrix)
 {
-    unordered_set<int> candidateSizes;
+    vector<int> candidateSizes;
 
     int numInRepeatReads = 0;
     int numFlankingReads = 0;
@@ -48,7 +48,7 @@ unordered_set<int> getAlleleCandidates(int readLen, int motifLen, const AlignMat
         auto topAlign = alignMatrix.getBestAlign(readIndex);
         if (topAlign.type() == StrAlign::Type::kSpanning)
         {
-            candidateSizes.insert(topAlign.numMotifs());
+            candidateSizes.push_back(topAlign.numMotifs());
             numFlankingReads += 2;
         }
         else if (topAlign.type() == StrAlign::Type::kFlanking)
@@ -64,47 +64,48 @@ unordered_set<int> getAlleleCandidates(int readLen, int motifLen, const AlignMat
 
     if (candidateSizes.empty() || *std::max_element(candidateSizes.begin(), candidateSizes.end()) < longestFlankingSize)
     {
-        candidateSizes.insert(longestFlankingSize);
+        candidateSizes.push_back(longestFlankingSize);
     }
 
     if (numFlankingReads > 0 && numInRepeatReads > 0)
     {
-        candidateSizes.insert(static_cast<int>(static_cast<double>(readLen) / motifLen));
+        candidateSizes.push_back(static_cast<int>(static_cast<double>(readLen) / motifLen));
         double depth = static_cast<double>(numFlankingReads) / 2;
         double mediumExpansion = readLen + static_cast<double>(numInRepeatReads * readLen) / depth;
-        candidateSizes.insert(static_cast<int>(mediumExpansion / motifLen));
+        candidateSizes.push_back(static_cast<int>(mediumExpansion / motifLen));
         double longExpansion = readLen + static_cast<double>(2 * numInRepeatReads * readLen) / depth;
-        candidateSizes.insert(static_cast<int>(longExpansion / motifLen));
+        candidateSizes.push_back(static_cast<int>(longExpansion / motifLen));
     }
 
+    std::sort(candidateSizes.begin(), candidateSizes.end());
+    candidateSizes.erase(std::unique(candidateSizes.begin(), candidateSizes.end()), candidateSizes.end());
+
     return candidateSizes;
 }
 
-vector<double> getTopFragLogliks(FragLogliks& loglikCalc, const unordered_set<int>& alleleCandidates)
+vector<double> getTopFragLogliks(FragLogliks& loglikCalc, const vector<int>& alleleCandidates)
 {
     const double negInf = std::numeric_limits<double>::lowest();
     vector<double> topFragLogliks(loglikCalc.numFrags(), negInf);
 
-    for (int fragIndex = 0; fragIndex != loglikCalc.numFrags(); ++fragIndex)
+    for (const int alleleSize : alleleCandidates)
     {
-        for (const int alleleSize : alleleCandidates)
+        const vector<double>& fragLogliks = loglikCalc.getLogliks(alleleSize);
+        for (int fragIndex = 0; fragIndex != loglikCalc.numFrags(); ++fragIndex)
         {
-            const double fragLoglik = loglikCalc.getLoglik(fragIndex, alleleSize);
-            if (fragLoglik > topFragLogliks[fragIndex])
-            {
-                topFragLogliks[fragIndex] = fragLoglik;
-            }
+            topFragLogliks[fragIndex] = std::max(topFragLogliks[fragIndex], fragLogliks[fragIndex]);
         }
     }
 
     return topFragLogliks;
 }
 
-RepeatGenotype genotype(AlleleCount alleleCount, int motifLen, int readLen, int fragLen, AlignMatrix& alignMatrix)
+RepeatGenotype
+genotype(AlleleCount alleleCount, int motifLen, int readLen, int fragLen, AlignMatrix& alignMatrix, int threadCount)
 {
     filter(alignMatrix);
-    FragLogliks fragLoglikCalc(motifLen, readLen, fragLen, &alignMatrix);
-    unordered_set<int> candidateAlleleSizes = getAlleleCandidates(readLen, motifLen, alignMatrix);
+    FragLogliks fragLoglikCalc(motifLen, readLen, fragLen, &alignMatrix, threadCount);
+    vector<int> candidateAlleleSizes = getAlleleCandidates(readLen, motifLen, alignMatrix);
     vector<double> topFragLogliks = getTopFragLogliks(fragLoglikCalc, candidateAlleleSizes);
 
     if (alleleCount == AlleleCount::kTwo)
@@ -21,7 +21,7 @@
 
 #pragma once
 
-#include <unordered_set>
+#include <vector>
 
 #include "core/Common.hh"
 #include "genotyping/AlignMatrix.hh"
@@ -32,9 +32,12 @@ namespace ehunter
 namespace strgt
 {
 
-std::unordered_set<int> getAlleleCandidates(int readLen, int motifLen, const AlignMatrix& alignMatrix);
+// Returns sorted sizes of alleles that the genotype search is restricted to
+std::vector<int> getAlleleCandidates(int readLen, int motifLen, const AlignMatrix& alignMatrix);
 
-RepeatGenotype genotype(AlleleCount alleleCount, int motifLen, int readLen, int fragLen, AlignMatrix& alignMatrix);
+// Loci supported by very many fragments are genotyped on up to threadCount threads
+RepeatGenotype genotype(
+    AlleleCount alleleCount, int motifLen, int readLen, int fragLen, AlignMatrix& alignMatrix, int threadCount = 1);
 
 }
 }
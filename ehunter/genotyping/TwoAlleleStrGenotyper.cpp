@@ -23,11 +23,15 @@
 
 #include "genotyping/TwoAlleleStrGenotyper.hh"
 
-#include <stack>
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <utility>
+#include <vector>
 
 #include "core/LogSum.hh"
 
-using std::unordered_set;
+using std::vector;
 
 namespace ehunter
 {
@@ -58,33 +62,34 @@ struct CiAndLoglik
     double loglik;
 };
 
-using LikelihoodFn = double (TwoAlleleGenotyper::*)(int, int);
-static Ci getCiAlongX(int bestX, int bestY, TwoAlleleGenotyper* genotyper, LikelihoodFn likelihood)
+template <typename LikelihoodFn>
+static Ci getCiAlongX(int bestX, int bestY, LikelihoodFn likelihood)
 {
     int xFrom = bestX;
     int xTo = bestX;
     int yFrom = bestY;
     int yTo = bestY;
 
-    std::stack<CiAndLoglik> ciCandidates;
-    double topGtLoglik = (genotyper->*likelihood)(bestX, bestY);
+    std::vector<CiAndLoglik> ciCandidates;
+    double topGtLoglik = likelihood(bestX, bestY);
     double totalLoglik = topGtLoglik;
-    ciCandidates.emplace(xFrom, xTo, totalLoglik);
+    ciCandidates.emplace_back(xFrom, xTo, totalLoglik);
 
     const int kMaxIntervalWidth = 750;
     double likelihoodRatio = 1;
     while (likelihoodRatio >= 0.01 && xTo - xFrom <= kMaxIntervalWidth)
     {
-        double llShiftLeft0 = (genotyper->*likelihood)(xFrom - 1, yFrom - 1);
-        double llShiftLeft1 = (genotyper->*likelihood)(xFrom - 1, yFrom);
-        double llShiftLeft2 = (genotyper->*likelihood)(xFrom - 1, yFrom + 1);
+        double llShiftLeft0 = likelihood(xFrom - 1, yFrom - 1);
+        double llShiftLeft1 = likelihood(xFrom - 1, yFrom);
+        double llShiftLeft2 = likelihood(xFrom - 1, yFrom + 1);
         double llShiftLeft = std::max(std::max(llShiftLeft0, llShiftLeft1), llShiftLeft2);
 
-        double llShiftRight0 = (genotyper->*likelihood)(xTo + 1, yTo + 1);
-        double llShiftRight1 = (genotyper->*likelihood)(xTo + 1, yTo);
-        double llShiftRight2 = (genotyper->*likelihood)(xTo + 1, yTo - 1);
+        double llShiftRight0 = likelihood(xTo + 1, yTo + 1);
+        double llShiftRight1 = likelihood(xTo + 1, yTo);
+        double llShiftRight2 = likelihood(xTo + 1, yTo - 1);
         double llShiftRight = std::max(std::max(llShiftRight0, llShiftRight1), llShiftRight2);
 
+        // The likelihood of the chosen genotype is the largest of the three candidates on its side
         double gtLoglik;
         if (llShiftLeft >= llShiftRight)
         {
@@ -92,13 +97,17 @@ static Ci getCiAlongX(int bestX, int bestY, TwoAlleleGenotyper* genotyper, Likel
             if (llShiftLeft0 > llShiftLeft1 && llShiftLeft0 > llShiftLeft2)
             {
                 yFrom -= 1;
+                gtLoglik = llShiftLeft0;
             }
             else if (llShiftLeft2 > llShiftLeft0 && llShiftLeft2 > llShiftLeft1)
             {
                 yFrom += 1;
+                gtLoglik = llShiftLeft2;
+            }
+            else
+            {
+                gtLoglik = llShiftLeft1;
             }
-
-            gtLoglik = (genotyper->*likelihood)(xFrom, yFrom);
         }
         else
         {
@@ -106,25 +115,29 @@ static Ci getCiAlongX(int bestX, int bestY, TwoAlleleGenotyper* genotyper, Likel
             if (llShiftRight0 > llShiftRight1 && llShiftRight0 > llShiftRight2)
             {
                 yTo += 1;
+                gtLoglik = llShiftRight0;
             }
             else if (llShiftRight2 > llShiftRight0 && llShiftRight2 > llShiftRight1)
             {
                 yTo -= 1;
+                gtLoglik = llShiftRight2;
+            }
+            else
+            {
+                gtLoglik = llShiftRight1;
             }
-
-            gtLoglik = (genotyper->*likelihood)(xTo, yTo);
         }
 
         totalLoglik = getLogSum(totalLoglik, gtLoglik);
-        ciCandidates.emplace(xFrom, xTo, totalLoglik);
+        ciCandidates.emplace_back(xFrom, xTo, totalLoglik);
         likelihoodRatio = std::exp(gtLoglik - topGtLoglik);
     }
 
-    auto ciCandidate = ciCandidates.top();
-    while (ciCandidates.size() > 1)
+    // Narrowest interval holding at least 95% of the total probability
+    auto ciCandidate = ciCandidates.back();
+    for (int candidateIndex = static_cast<int>(ciCandidates.size()) - 2; candidateIndex >= 0; --candidateIndex)
     {
-        ciCandidates.pop();
-        auto nextCiCandidate = ciCandidates.top();
+        const auto& nextCiCandidate = ciCandidates[candidateIndex];
         const double ciProbability = std::exp(nextCiCandidate.loglik - totalLoglik);
         if (ciProbability >= 0.95)
         {
@@ -139,13 +152,27 @@ static Ci getCiAlongX(int bestX, int bestY, TwoAlleleGenotyper* genotyper, Likel
     return { ciCandidate.startSize, ciCandidate.endSize };
 }
 
-RepeatGenotype TwoAlleleGenotyper::genotype(const unordered_set<int>& alleleSizeCandidates)
+RepeatGenotype TwoAlleleGenotyper::genotype(const vector<int>& alleleSizeCandidates)
 {
     RepeatGenotype gt = getMostLikelyGenotype(alleleSizeCandidates);
     const int bestShortSize = gt.shortAlleleSizeInUnits();
     const int bestLongSize = gt.longAlleleSizeInUnits();
-    Ci shortStrCi = getCiAlongX(bestShortSize, bestLongSize, this, &TwoAlleleGenotyper::getShortAndLongAlleleLoglik);
-    Ci longStrCi = getCiAlongX(bestLongSize, bestShortSize, this, &TwoAlleleGenotyper::getLongAndShortAlleleLoglik);
+    auto getShortAlleleCi = [this, bestShortSize, bestLongSize]() {
+        return getCiAlongX(bestShortSize, bestLongSize, [this](int shortAlleleSize, int longAlleleSize) {
+            return getShortAndLongAlleleLoglik(shortAlleleSize, longAlleleSize);
+        });
+    };
+    auto getLongAlleleCi = [this, bestShortSize, bestLongSize]() {
+        return getCiAlongX(bestLongSize, bestShortSize, [this](int longAlleleSize, int shortAlleleSize) {
+            return getLongAndShortAlleleLoglik(longAlleleSize, shortAlleleSize);
+        });
+    };
+
+    // The two searches only share cached likelihoods, so loci with many fragments run them concurrently
+    const auto launchPolicy = fragLogliks_.threadCount() > 1 ? std::launch::async : std::launch::deferred;
+    std::future<Ci> longStrCiResult = std::async(launchPolicy, getLongAlleleCi);
+    Ci shortStrCi = getShortAlleleCi();
+    Ci longStrCi = longStrCiResult.get();
 
     gt.setShortAlleleSizeInUnitsCi(shortStrCi.begin, shortStrCi.end);
     gt.setLongAlleleSizeInUnitsCi(longStrCi.begin, longStrCi.end);
@@ -153,29 +180,61 @@ RepeatGenotype TwoAlleleGenotyper::genotype(const unordered_set<int>& alleleSize
     return gt;
 }
 
-RepeatGenotype TwoAlleleGenotyper::getMostLikelyGenotype(const unordered_set<int>& alleleSizeCandidates)
+RepeatGenotype TwoAlleleGenotyper::getMostLikelyGenotype(const vector<int>& alleleSizeCandidates)
 {
+    // Genotypes made of alleles that explain the fragments well on their own are evaluated first, so that most of the
+    // remaining genotypes can be abandoned after a few fragments
+    vector<double> alleleScores;
+    for (int alleleSize : alleleSizeCandidates)
+    {
+        const vector<double>& fragLogliks = fragLogliks_.getLogliks(alleleSize);
+        alleleScores.push_back(
+            sumLogSums(mismapTerms_.data(), fragLogliks.data(), kLogRightmapPrior, fragLogliks_.numFrags()));
+    }
+
+    vector<std::pair<int, int>> genotypes;
+    for (int shortIndex = 0; shortIndex != static_cast<int>(alleleSizeCandidates.size()); ++shortIndex)
+    {
+        for (int longIndex = shortIndex; longIndex != static_cast<int>(alleleSizeCandidates.size()); ++longIndex)
+        {
+            genotypes.emplace_back(shortIndex, longIndex);
+        }
+    }
+    std::stable_sort(
+        genotypes.begin(), genotypes.end(),
+        [&alleleScores](const std::pair<int, int>& genotype, const std::pair<int, int>& otherGenotype) {
+            return alleleScores[genotype.first] + alleleScores[genotype.second]
+                > alleleScores[otherGenotype.first] + alleleScores[otherGenotype.second];
+        });
+
     double maxGtLoglik = std::numeric_limits<double>::lowest();
     int bestShortAlleleSize = 0;
     int bestLongAlleleSize = 0;
 
-    for (int shortAlleleSize : alleleSizeCandidates)
+    for (const auto& genotype : genotypes)
     {
-        for (int longAlleleSize : alleleSizeCandidates)
-        {
-            if (shortAlleleSize > longAlleleSize)
-            {
-                continue;
-            }
+        const int shortAlleleSize = alleleSizeCandidates[genotype.first];
+        const int longAlleleSize = alleleSizeCandidates[genotype.second];
 
-            const double gtLoglik = getShortAndLongAlleleLoglik(shortAlleleSize, longAlleleSize);
+        double gtLoglik;
+        if (!tryComputeShortAndLongAlleleLoglik(shortAlleleSize, longAlleleSize, maxGtLoglik, gtLoglik))
+        {
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(genotypeLogliksMutex_);
+            genotypeLogliks_.emplace(std::make_pair(shortAlleleSize, longAlleleSize), gtLoglik);
+        }
 
-            if (maxGtLoglik < gtLoglik)
-            {
-                maxGtLoglik = gtLoglik;
-                bestShortAlleleSize = shortAlleleSize;
-                bestLongAlleleSize = longAlleleSize;
-            }
+        // Ties go to the genotype with shorter alleles regardless of the evaluation order
+        const bool isTiedAndShorter = maxGtLoglik == gtLoglik
+            && std::make_pair(shortAlleleSize, longAlleleSize)
+                < std::make_pair(bestShortAlleleSize, bestLongAlleleSize);
+        if (maxGtLoglik < gtLoglik || isTiedAndShorter)
+        {
+            maxGtLoglik = gtLoglik;
+            bestShortAlleleSize = shortAlleleSize;
+            bestLongAlleleSize = longAlleleSize;
         }
     }
 
@@ -189,27 +248,54 @@ double TwoAlleleGenotyper::getShortAndLongAlleleLoglik(int shortAlleleSize, int
         return std::numeric_limits<double>::lowest();
     }
 
+    // Neighbouring steps of the confidence interval search revisit the same genotypes
+    const auto genotype = std::make_pair(shortAlleleSize, longAlleleSize);
+    {
+        std::lock_guard<std::mutex> lock(genotypeLogliksMutex_);
+        auto cachedLoglik = genotypeLogliks_.find(genotype);
+        if (cachedLoglik != genotypeLogliks_.end())
+        {
+            return cachedLoglik->second;
+        }
+    }
+
+    const double noTarget = std::numeric_limits<double>::lowest();
+    double genotypeLoglik;
+    tryComputeShortAndLongAlleleLoglik(shortAlleleSize, longAlleleSize, noTarget, genotypeLoglik);
+    std::lock_guard<std::mutex> lock(genotypeLogliksMutex_);
+    genotypeLogliks_.emplace(genotype, genotypeLoglik);
+    return genotypeLoglik;
+}
+
+bool TwoAlleleGenotyper::tryComputeShortAndLongAlleleLoglik(
+    int shortAlleleSize, int longAlleleSize, double loglikToReach, double& genotypeLoglik)
+{
     const int shortAlleleLen = shortAlleleSize * motifLen_ + fragLen_ + 1;
     const int longAlleleLen = longAlleleSize * motifLen_ + fragLen_ + 1;
     const double shortAlleleFrac = static_cast<double>(shortAlleleLen) / (shortAlleleLen + longAlleleLen);
-    double genotypeLoglik = 0;
+    const double shortAlleleLogFrac = std::log(shortAlleleFrac);
+    const double longAlleleLogFrac = std::log(1.0 - shortAlleleFrac);
 
+    const std::vector<double>& shortAlleleFragLogliks = fragLogliks_.getLogliks(shortAlleleSize);
+    const std::vector<double>& longAlleleFragLogliks = fragLogliks_.getLogliks(longAlleleSize);
+
+    // Margin that keeps rounding errors from abandoning a genotype that ties with the target
+    const double kRoundingMargin = 1e-6;
+    genotypeLoglik = 0;
     for (int fragIndex = 0; fragIndex != fragLogliks_.numFrags(); ++fragIndex)
     {
-        double fragLoglikForShortAllele = fragLogliks_.getLoglik(fragIndex, shortAlleleSize);
-        double fragLoglikForLongAllele = fragLogliks_.getLoglik(fragIndex, longAlleleSize);
-
-        const double shortAlleleTerm = std::log(shortAlleleFrac) + fragLoglikForShortAllele;
-        const double longAlleleTerm = std::log(1.0 - shortAlleleFrac) + fragLoglikForLongAllele;
-
+        const double shortAlleleTerm = shortAlleleLogFrac + shortAlleleFragLogliks[fragIndex];
+        const double longAlleleTerm = longAlleleLogFrac + longAlleleFragLogliks[fragIndex];
         const double loglikGivenRightmap = getLogSum(shortAlleleTerm, longAlleleTerm);
-        const double loglikGivenMismap = topFragLogliks_[fragIndex];
-        const double mismapPrior = std::log(0.001);
-        const double rightmapPrior = std::log(1.0 - 0.001);
-        genotypeLoglik += getLogSum(mismapPrior + loglikGivenMismap, rightmapPrior + loglikGivenRightmap);
+        genotypeLoglik += getLogSum(mismapTerms_[fragIndex], kLogRightmapPrior + loglikGivenRightmap);
+
+        if (genotypeLoglik + maxTermSuffixSums_[fragIndex + 1] + kRoundingMargin < loglikToReach)
+        {
+            return false;
+        }
     }
 
-    return genotypeLoglik;
+    return true;
 }
 
 double TwoAlleleGenotyper::getLongAndShortAlleleLoglik(int longAlleleSize, int shortAlleleSize)
@@ -217,5 +303,22 @@ double TwoAlleleGenotyper::getLongAndShortAlleleLoglik(int longAlleleSize, int s
     return getShortAndLongAlleleLoglik(shortAlleleSize, longAlleleSize);
 }
 
+void TwoAlleleGenotyper::initializeFragTerms(const std::vector<double>& topFragLogliks)
+{
+    mismapTerms_.reserve(topFragLogliks.size());
+    for (const double loglikGivenMismap : topFragLogliks)
+    {
+        mismapTerms_.push_back(kLogMismapPrior + loglikGivenMismap);
+    }
+
+    // A fragment contributes the most when it is explained by its best allele candidate
+    maxTermSuffixSums_.assign(topFragLogliks.size() + 1, 0);
+    for (int fragIndex = static_cast<int>(topFragLogliks.size()) - 1; fragIndex != -1; --fragIndex)
+    {
+        const double maxTerm = getLogSum(mismapTerms_[fragIndex], kLogRightmapPrior + topFragLogliks[fragIndex]);
+        maxTermSuffixSums_[fragIndex] = maxTermSuffixSums_[fragIndex + 1] + maxTerm;
+    }
+}
+
 }
 }
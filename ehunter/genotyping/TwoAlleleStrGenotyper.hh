@@ -23,8 +23,10 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
-#include <unordered_set>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 #include "genotyping/FragLogliks.hh"
@@ -41,24 +43,33 @@ public:
     TwoAlleleGenotyper(int motifLen, int fragLen, std::vector<double> topFragLogliks, FragLogliks* fragLogliksPtr)
         : motifLen_(motifLen)
         , fragLen_(fragLen)
-        , topFragLogliks_(std::move(topFragLogliks))
         , fragLogliks_(*fragLogliksPtr)
     {
+        initializeFragTerms(topFragLogliks);
     }
 
-    RepeatGenotype genotype(const std::unordered_set<int>& alleleSizeCandidates);
+    RepeatGenotype genotype(const std::vector<int>& alleleSizeCandidates);
 
 private:
-    using ReadIndexAndNumMotifs = std::pair<int, int>;
+    using ShortAndLongAlleleSizes = std::pair<int, int>;
 
-    RepeatGenotype getMostLikelyGenotype(const std::unordered_set<int>& alleleSizeCandidates);
+    RepeatGenotype getMostLikelyGenotype(const std::vector<int>& alleleSizeCandidates);
     double getShortAndLongAlleleLoglik(int shortAlleleSize, int longAlleleSize);
+    // Returns false as soon as the log-likelihood of the genotype is known to be below the target
+    bool tryComputeShortAndLongAlleleLoglik(
+        int shortAlleleSize, int longAlleleSize, double loglikToReach, double& genotypeLoglik);
     double getLongAndShortAlleleLoglik(int longAlleleSize, int shortAlleleSize);
+    void initializeFragTerms(const std::vector<double>& topFragLogliks);
 
     int motifLen_;
     int fragLen_;
-    std::vector<double> topFragLogliks_;
     FragLogliks& fragLogliks_;
+    // Log-likelihoods of the fragments given that they are mismapped, weighted by the mismapping prior
+    std::vector<double> mismapTerms_;
+    // Upper bounds on the contribution of the fragments from the given one onwards to any genotype log-likelihood
+    std::vector<double> maxTermSuffixSums_;
+    std::map<ShortAndLongAlleleSizes, double> genotypeLogliks_;
+    std::mutex genotypeLogliksMutex_;
 };
 
 }
@@ -21,38 +21,223 @@
 
 #include "locus/AlignmentBuffer.hh"
 
+#include <array>
+#include <cctype>
+
 namespace ehunter
 {
 namespace locus
 {
 
-/// \brief Return true if alignment overlaps with segment 1 in the LocusStructure
-///
-/// Note this isn't generalized to recognize all segments which are repeats in more complex locus structures, it should
-/// only work with a single expansion like RFC1.
-///
-static bool testRepeatMotifOverlap(const graphtools::GraphAlignment& readAlign)
+namespace
+{
+// Same base order as the htslib 4-bit base encoding
+const char kBaseCodeToBase[] = "=ACMGRSVTWYHKDBN";
+const uint8_t kUnknownBaseCode = 15;
+
+class BaseCodeTable
+{
+public:
+    BaseCodeTable()
+    {
+        codes_.fill(kUnknownBaseCode);
+        for (uint8_t code = 0; code != 16; ++code)
+        {
+            const auto base = static_cast<unsigned char>(kBaseCodeToBase[code]);
+            codes_[base] = code;
+            codes_[std::tolower(base)] = code;
+        }
+    }
+
+    uint8_t operator[](char base) const { return codes_[static_cast<unsigned char>(base)]; }
+
+private:
+    std::array<uint8_t, 256> codes_;
+};
+
+const BaseCodeTable kBaseCodes;
+
+const int kOperationTypeShift = 29;
+}
+
+bool AlignmentBufferBudget::tryReserve(std::size_t numBytes)
+{
+    std::size_t usedBytes = usedBytes_.load();
+    do
+    {
+        if (usedBytes + numBytes > maxBytes_)
+        {
+            return false;
+        }
+    } while (!usedBytes_.compare_exchange_weak(usedBytes, usedBytes + numBytes));
+
+    return true;
+}
+
+std::size_t PackedAlignmentBuffer::Record::numBytes() const
+{
+    return sizeof(Record) + packedBases.size() + lowQualityMask.size() + packedAlignment.size() * sizeof(uint32_t);
+}
+
+PackedAlignmentBuffer::PackedAlignmentBuffer(
+    const graphtools::Graph* graph, std::size_t maxBytes, std::shared_ptr<AlignmentBufferBudget> sharedBudget)
+    : graph_(graph)
+    , maxBytes_(maxBytes)
+    , sharedBudget_(std::move(sharedBudget))
+{
+}
+
+PackedAlignmentBuffer::~PackedAlignmentBuffer()
+{
+    if (sharedBudget_)
+    {
+        sharedBudget_->release(stats_.numBytes);
+    }
+}
+
+PackedAlignmentBuffer::Record PackedAlignmentBuffer::pack(
+    const std::string& read, const bool isReversed, const graphtools::GraphAlignment& readAlignment)
 {
-    for (size_t index(0); index < readAlign.size(); ++index)
+    Record record;
+    record.readLength = read.size();
+    record.isReversed = isReversed;
+
+    record.packedBases.assign((read.size() + 1) / 2, 0);
+    record.lowQualityMask.assign((read.size() + 7) / 8, 0);
+    for (std::size_t index = 0; index != read.size(); ++index)
+    {
+        record.packedBases[index / 2] |= kBaseCodes[read[index]] << (4 * (index % 2));
+        if (std::islower(static_cast<unsigned char>(read[index])))
+        {
+            record.lowQualityMask[index / 8] |= 1 << (index % 8);
+        }
+    }
+
+    const graphtools::Path& path = readAlignment.path();
+    record.pathStart = path.startPosition();
+    record.pathEnd = path.endPosition();
+    for (std::size_t nodeIndex = 0; nodeIndex != readAlignment.size(); ++nodeIndex)
     {
-        if (readAlign.path().getNodeIdByIndex(index) == 1)
+        const graphtools::Alignment& nodeAlignment = readAlignment[nodeIndex];
+        record.packedAlignment.push_back(path.getNodeIdByIndex(nodeIndex));
+        record.packedAlignment.push_back(nodeAlignment.referenceStart());
+        record.packedAlignment.push_back(nodeAlignment.numOperations());
+        for (const auto& operation : nodeAlignment)
         {
-            return true;
+            const auto type = static_cast<uint32_t>(operation.type());
+            record.packedAlignment.push_back((type << kOperationTypeShift) | operation.length());
         }
     }
-    return false;
+
+    return record;
+}
+
+bool PackedAlignmentBuffer::tryReserve(std::size_t numBytes)
+{
+    if (stats_.numBytes + numBytes > maxBytes_)
+    {
+        return false;
+    }
+    if (sharedBudget_ && !sharedBudget_->tryReserve(numBytes))
+    {
+        return false;
+    }
+
+    stats_.numBytes += numBytes;
+    stats_.maxNumBytes = std::max(stats_.maxNumBytes, stats_.numBytes);
+    return true;
+}
+
+void PackedAlignmentBuffer::release(std::size_t numBytes)
+{
+    stats_.numBytes -= numBytes;
+    if (sharedBudget_)
+    {
+        sharedBudget_->release(numBytes);
+    }
 }
 
-void AlignmentBuffer::testAndPushRead(
+void PackedAlignmentBuffer::testAndAddRead(
     const std::string& read, const bool isReversed, const graphtools::GraphAlignment& readAlignment)
 {
-    // Test if the read should be included in the buffer, for now just check that the read touches the repeat at all
-    if (not testRepeatMotifOverlap(readAlignment))
+    ++stats_.numReadsSeen;
+
+    if (!isSampling_)
+    {
+        Record record = pack(read, isReversed, readAlignment);
+        if (tryReserve(record.numBytes()))
+        {
+            records_.push_back(std::move(record));
+            return;
+        }
+        isSampling_ = true;
+    }
+
+    // Reservoir sampling: the read replaces a random stored read with probability size / numReadsSeen
+    std::uniform_int_distribution<int> indexDistribution(0, stats_.numReadsSeen - 1);
+    const auto recordIndex = static_cast<std::size_t>(indexDistribution(randomEngine_));
+    if (recordIndex >= records_.size())
+    {
+        ++stats_.numReadsDiscarded;
+        return;
+    }
+
+    Record record = pack(read, isReversed, readAlignment);
+    const std::size_t newNumBytes = record.numBytes();
+    const std::size_t oldNumBytes = records_[recordIndex].numBytes();
+    if (newNumBytes > oldNumBytes && !tryReserve(newNumBytes - oldNumBytes))
     {
+        ++stats_.numReadsDiscarded;
         return;
     }
+    if (newNumBytes < oldNumBytes)
+    {
+        release(oldNumBytes - newNumBytes);
+    }
+
+    records_[recordIndex] = std::move(record);
+    ++stats_.numReadsReplaced;
+}
+
+AlignmentBufferData PackedAlignmentBuffer::getRead(std::size_t index) const
+{
+    const Record& record = records_[index];
+
+    std::string read(record.readLength, 'N');
+    for (std::size_t baseIndex = 0; baseIndex != read.size(); ++baseIndex)
+    {
+        const uint8_t baseCode = (record.packedBases[baseIndex / 2] >> (4 * (baseIndex % 2))) & 0xF;
+        read[baseIndex] = kBaseCodeToBase[baseCode];
+        if (record.lowQualityMask[baseIndex / 8] & (1 << (baseIndex % 8)))
+        {
+            read[baseIndex] = std::tolower(read[baseIndex]);
+        }
+    }
+
+    std::vector<graphtools::NodeId> nodeIds;
+    std::vector<graphtools::Alignment> nodeAlignments;
+    std::size_t wordIndex = 0;
+    while (wordIndex != record.packedAlignment.size())
+    {
+        nodeIds.push_back(record.packedAlignment[wordIndex]);
+        const uint32_t referenceStart = record.packedAlignment[wordIndex + 1];
+        const uint32_t numOperations = record.packedAlignment[wordIndex + 2];
+        wordIndex += 3;
+
+        graphtools::Alignment::Operations operations;
+        operations.reserve(numOperations);
+        for (uint32_t operationIndex = 0; operationIndex != numOperations; ++operationIndex, ++wordIndex)
+        {
+            const uint32_t packedOperation = record.packedAlignment[wordIndex];
+            const auto type = static_cast<graphtools::OperationType>(packedOperation >> kOperationTypeShift);
+            operations.emplace_back(type, packedOperation & graphtools::Operation::kMaxLength);
+        }
+        nodeAlignments.emplace_back(referenceStart, std::move(operations));
+    }
 
-    bufData_.emplace_back(AlignmentBufferData { read, isReversed, readAlignment });
+    graphtools::Path path(graph_, record.pathStart, nodeIds, record.pathEnd);
+    graphtools::GraphAlignment readAlignment(std::move(path), std::move(nodeAlignments));
+    return { std::move(read), record.isReversed, std::move(readAlignment) };
 }
 
 }
@@ -21,16 +21,61 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
 #include "graphalign/GraphAlignment.hh"
+#include "graphcore/Graph.hh"
 
 namespace ehunter
 {
 namespace locus
 {
 
+/// \brief Receiver of read alignments at a single locus
+///
+/// These read alignments are not needed for standard repeat expansion calling, but are passed on for special
+/// locus-specific calling extensions, which may either store them or reduce them as they arrive.
+///
+class AlignmentBuffer
+{
+public:
+    virtual ~AlignmentBuffer() = default;
+
+    /// Test if the given read meets inclusion criteria, and if so, add it to the buffer
+    virtual void
+    testAndAddRead(const std::string& read, bool isReversed, const graphtools::GraphAlignment& readAlignment)
+        = 0;
+};
+
+/// \brief Memory budget shared by the alignment buffers of all loci
+///
+class AlignmentBufferBudget
+{
+public:
+    explicit AlignmentBufferBudget(std::size_t maxBytes)
+        : maxBytes_(maxBytes)
+        , usedBytes_(0)
+    {
+    }
+
+    /// Reserve the given number of bytes if this keeps the total within the budget
+    bool tryReserve(std::size_t numBytes);
+    void release(std::size_t numBytes) { usedBytes_ -= numBytes; }
+
+    std::size_t maxBytes() const { return maxBytes_; }
+    std::size_t usedBytes() const { return usedBytes_.load(); }
+
+private:
+    const std::size_t maxBytes_;
+    std::atomic<std::size_t> usedBytes_;
+};
+
 struct AlignmentBufferData
 {
     std::string read;
@@ -38,25 +83,76 @@ struct AlignmentBufferData
     graphtools::GraphAlignment readAlignment;
 };
 
-/// \brief Buffer for read alignments at a single locus
+struct AlignmentBufferStats
+{
+    /// Reads offered to the buffer
+    int numReadsSeen = 0;
+    /// Reads replacing a stored read after the memory budget was reached
+    int numReadsReplaced = 0;
+    /// Reads discarded after the memory budget was reached
+    int numReadsDiscarded = 0;
+    std::size_t numBytes = 0;
+    std::size_t maxNumBytes = 0;
+};
+
+/// \brief Buffer storing packed read alignments within a memory budget
 ///
-/// These read alignments are not needed for standard repeat expansion calling, but are stored for special
-/// locus-specific calling extensions.
+/// Bases take 4 bits each, with one more bit per base for the low-quality state encoded by case; bases other than
+/// IUPAC codes are stored as N. Graph alignments are stored as node ids and packed alignment operations.
 ///
-/// This buffer has currently been written to fulfil the requirements of the RFC1 motif analyzer only.
+/// Reads are stored until either the per-locus limit or the shared budget is reached. From then on the buffer holds a
+/// uniform random sample (reservoir sample) of all reads seen so far, so buffered reads stay representative of
+/// high-depth or expanded loci.
 ///
-class AlignmentBuffer
+class PackedAlignmentBuffer : public AlignmentBuffer
 {
 public:
-    using buffer_t = std::vector<AlignmentBufferData>;
+    /// \param[in] graph Graph that all buffered reads are aligned to
+    ///
+    /// \param[in] maxBytes Memory limit for the reads buffered at this locus
+    ///
+    /// \param[in] sharedBudget Memory budget shared with other loci, or null if there is none
+    ///
+    PackedAlignmentBuffer(
+        const graphtools::Graph* graph, std::size_t maxBytes,
+        std::shared_ptr<AlignmentBufferBudget> sharedBudget = nullptr);
+    ~PackedAlignmentBuffer() override;
 
-    /// Test if the given read meets inclusion criteria, and if so, store it in the buffer
-    void testAndPushRead(const std::string& read, bool isReversed, const graphtools::GraphAlignment& readAlignment);
+    void
+    testAndAddRead(const std::string& read, bool isReversed, const graphtools::GraphAlignment& readAlignment) override;
 
-    const buffer_t& getBuffer() const { return bufData_; }
+    std::size_t size() const { return records_.size(); }
+    AlignmentBufferData getRead(std::size_t index) const;
+    const AlignmentBufferStats& stats() const { return stats_; }
 
 private:
-    buffer_t bufData_;
+    struct Record
+    {
+        int32_t readLength;
+        bool isReversed;
+        // Bases as htslib 4-bit codes, two per byte
+        std::vector<uint8_t> packedBases;
+        // One bit per base set for low-quality (lowercase) bases
+        std::vector<uint8_t> lowQualityMask;
+        int32_t pathStart;
+        int32_t pathEnd;
+        // For each node: node id, reference start, operation count, then the packed operations
+        std::vector<uint32_t> packedAlignment;
+
+        std::size_t numBytes() const;
+    };
+
+    static Record pack(const std::string& read, bool isReversed, const graphtools::GraphAlignment& readAlignment);
+    bool tryReserve(std::size_t numBytes);
+    void release(std::size_t numBytes);
+
+    const graphtools::Graph* graph_;
+    const std::size_t maxBytes_;
+    std::shared_ptr<AlignmentBufferBudget> sharedBudget_;
+    std::vector<Record> records_;
+    bool isSampling_ = false;
+    std::mt19937 randomEngine_;
+    AlignmentBufferStats stats_;
 };
 
 }
@@ -0,0 +1,106 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#include "locus/AlignmentBuffer.hh"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "graphalign/GraphAlignmentOperations.hh"
+#include "graphcore/GraphBuilders.hh"
+
+using graphtools::decodeGraphAlignment;
+using graphtools::Graph;
+using graphtools::GraphAlignment;
+using std::string;
+using namespace ehunter;
+using namespace locus;
+
+namespace
+{
+const string kLeftFlank = "CTGTGTGTCTATAGCGTGTCAGGTCCTGCC";
+const string kRightFlank = "TTCCATCCTCATCTACACTCATTAGGCCTG";
+const string kRead = "TGTCAGGTCCTGCCCAGCAGCAGCAGTTCCATCC";
+const string kReadCigar = "0[14M]1[3M]1[1M1X1M]1[2M1D]1[1I3M]2[8M]";
+}
+
+TEST(PackedAlignmentBufferTest, BufferedRead_DecodedUnchanged)
+{
+    const Graph graph = graphtools::makeStrGraph(kLeftFlank, "CAG", kRightFlank);
+    PackedAlignmentBuffer buffer(&graph, 1000);
+
+    const string read = "TGTCAGGTccTGCCCAGCNGCAGCAGRTCCAtcc";
+    const GraphAlignment alignment = decodeGraphAlignment(16, kReadCigar, &graph);
+    buffer.testAndAddRead(read, true, alignment);
+
+    ASSERT_EQ(1u, buffer.size());
+    const AlignmentBufferData data = buffer.getRead(0);
+    EXPECT_EQ(read, data.read);
+    EXPECT_TRUE(data.isReversed);
+    EXPECT_EQ(alignment, data.readAlignment);
+}
+
+TEST(PackedAlignmentBufferTest, ReadsBeyondLimit_SampledWithinLimit)
+{
+    const Graph graph = graphtools::makeStrGraph(kLeftFlank, "CAG", kRightFlank);
+    const GraphAlignment alignment = decodeGraphAlignment(16, kReadCigar, &graph);
+    PackedAlignmentBuffer buffer(&graph, 1000);
+
+    for (int readIndex = 0; readIndex != 200; ++readIndex)
+    {
+        buffer.testAndAddRead(kRead, false, alignment);
+    }
+
+    const AlignmentBufferStats& stats = buffer.stats();
+    EXPECT_EQ(200, stats.numReadsSeen);
+    EXPECT_LT(buffer.size(), 200u);
+    EXPECT_LE(stats.maxNumBytes, 1000u);
+    EXPECT_EQ(200, static_cast<int>(buffer.size()) + stats.numReadsReplaced + stats.numReadsDiscarded);
+    EXPECT_GT(stats.numReadsReplaced, 0);
+}
+
+TEST(PackedAlignmentBufferTest, BuffersSharingBudget_StayWithinBudget)
+{
+    const Graph graph = graphtools::makeStrGraph(kLeftFlank, "CAG", kRightFlank);
+    const GraphAlignment alignment = decodeGraphAlignment(16, kReadCigar, &graph);
+    auto budget = std::make_shared<AlignmentBufferBudget>(1000);
+
+    PackedAlignmentBuffer firstBuffer(&graph, 100000, budget);
+    PackedAlignmentBuffer secondBuffer(&graph, 100000, budget);
+    for (int readIndex = 0; readIndex != 100; ++readIndex)
+    {
+        firstBuffer.testAndAddRead(kRead, false, alignment);
+        secondBuffer.testAndAddRead(kRead, false, alignment);
+    }
+
+    EXPECT_LE(budget->usedBytes(), 1000u);
+    EXPECT_EQ(budget->usedBytes(), firstBuffer.stats().numBytes + secondBuffer.stats().numBytes);
+    EXPECT_GT(firstBuffer.size(), 0u);
+    EXPECT_GT(secondBuffer.size(), 0u);
+
+    {
+        PackedAlignmentBuffer thirdBuffer(&graph, 100000, budget);
+    }
+    EXPECT_EQ(budget->usedBytes(), firstBuffer.stats().numBytes + secondBuffer.stats().numBytes);
+}
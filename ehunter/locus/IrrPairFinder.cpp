@@ -38,9 +38,8 @@ IrrPairFinder::IrrPairFinder(string motif)
 
 bool IrrPairFinder::check(const string& read, const string& mate) const
 {
-    const bool isFirstReadIrr = purityCalculator_.score(read) >= purityCutoff_;
-    const bool isSecondReadIrr = purityCalculator_.score(mate) >= purityCutoff_;
-    return isFirstReadIrr && isSecondReadIrr;
+    // The mate is only scored if the read passes
+    return purityCalculator_.score(read) >= purityCutoff_ && purityCalculator_.score(mate) >= purityCutoff_;
 }
 
 }
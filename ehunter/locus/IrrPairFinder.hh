@@ -19,6 +19,8 @@
 //
 //
 
+#pragma once
+
 #include <string>
 
 #include "core/WeightedPurityCalculator.hh"
@@ -34,6 +36,7 @@ public:
     explicit IrrPairFinder(std::string motif);
 
     const std::string& targetMotif() const { return targetMotif_; }
+    double purityCutoff() const { return purityCutoff_; }
     bool check(const std::string& read, const std::string& mate) const;
 
 private:
@@ -31,36 +31,68 @@ namespace locus
 
 LocusAligner::LocusAligner(
     std::string locusId, GraphPtr graph, const HeuristicParameters& params, AlignmentWriterPtr writer,
-    AlignmentBufferPtr buffer)
+    AlignmentBufferPtr alignmentBuffer)
     : locusId_(std::move(locusId))
+    , seedKmerLength_(params.kmerLenForAlignment())
     , aligner_(graph, params.kmerLenForAlignment(), params.paddingLength(), params.seedAffixTrimLength())
     , orientationPredictor_(graph, params.orientationPredictorKmerLen(), params.orientationPredictorMinKmerCount())
+    , flankKmerIndex_(*graph, params.orientationPredictorKmerLen())
     , writer_(std::move(writer))
-    , alignmentBuffer_(std::move(buffer))
+    , alignmentBuffer_(std::move(alignmentBuffer))
 {
 }
 
 LocusAligner::AlignedPair LocusAligner::align(Read& read, Read* mate, graphtools::AlignerSelector& alignerSelector)
 {
-    auto readAlign = align(read, alignerSelector);
-    auto mateAlign = mate ? align(*mate, alignerSelector) : boost::none;
-
     int numMatchingBases = static_cast<int>(static_cast<double>(read.sequence().length()) / 7.5);
     numMatchingBases = std::max(numMatchingBases, 10);
     LinearAlignmentParameters parameters;
     const int kMinNonRepeatAlignmentScore = numMatchingBases * parameters.matchScore;
 
+    std::vector<bool> readKmerMatches;
+    std::vector<bool> mateKmerMatches;
+    const bool isReadOriented = orient(read, readKmerMatches);
+    const bool isMateOriented = mate && orient(*mate, mateKmerMatches);
+
+    if (!isReadOriented && !isMateOriented)
+    {
+        ++stats_.numPairsRejectedByOrientation;
+        return { boost::none, boost::none };
+    }
+
+    int numFlankKmerBases = 0;
+    if (isReadOriented)
+    {
+        numFlankKmerBases += flankKmerIndex_.countBasesCoveredByFlankKmers(read.sequence());
+    }
+    if (isMateOriented)
+    {
+        numFlankKmerBases += flankKmerIndex_.countBasesCoveredByFlankKmers(mate->sequence());
+    }
+
+    if (numFlankKmerBases * parameters.matchScore < kMinNonRepeatAlignmentScore)
+    {
+        ++stats_.numPairsRejectedByFlankKmers;
+        return { boost::none, boost::none };
+    }
+
+    auto readAlign = isReadOriented ? align(read, readKmerMatches, alignerSelector) : boost::none;
+    auto mateAlign = isMateOriented ? align(*mate, mateKmerMatches, alignerSelector) : boost::none;
+
     if (!checkIfLocallyPlacedReadPair(readAlign, mateAlign, kMinNonRepeatAlignmentScore))
     {
+        ++stats_.numPairsRejectedByAlignmentScore;
         return { boost::none, boost::none };
     }
 
+    ++stats_.numPairsAligned;
+
     if (readAlign && mateAlign)
     {
-        // Optionally buffer reads for specialized caller extensions:
+        // Optionally accumulate read evidence for specialized caller extensions:
         if (alignmentBuffer_)
         {
-            alignmentBuffer_->testAndPushRead(read.sequence(), read.isReversed(), *readAlign);
+            alignmentBuffer_->testAndAddRead(read.sequence(), read.isReversed(), *readAlign);
         }
 
         // Output realigned reads to bam:
@@ -75,20 +107,54 @@ LocusAligner::AlignedPair LocusAligner::align(Read& read, Read* mate, graphtools
     return { readAlign, mateAlign };
 }
 
-LocusAligner::OptionalAlign LocusAligner::align(Read& read, graphtools::AlignerSelector& alignerSelector) const
+// A kmer of the seeding kmer length can only occur in the graph if every orientation kmer it contains does
+static std::vector<bool>
+getSeedCandidates(const std::vector<bool>& orientationKmerMatches, int orientationKmerLen, int seedKmerLen)
 {
-    OrientationPrediction predictedOrientation = orientationPredictor_.predict(read.sequence());
+    const int numOrientationKmersPerSeed = seedKmerLen - orientationKmerLen + 1;
+    const int numSeeds = static_cast<int>(orientationKmerMatches.size()) - numOrientationKmersPerSeed + 1;
+    if (numOrientationKmersPerSeed <= 0 || numSeeds <= 0)
+    {
+        return {};
+    }
 
-    if (predictedOrientation == OrientationPrediction::kAlignsInReverseComplementOrientation)
+    std::vector<bool> seedCandidates(numSeeds);
+    int numMatchesInWindow = 0;
+    for (int position = 0; position != static_cast<int>(orientationKmerMatches.size()); ++position)
     {
-        read.reverseComplement();
+        numMatchesInWindow += orientationKmerMatches[position];
+        const int seedStart = position - numOrientationKmersPerSeed + 1;
+        if (seedStart >= 0)
+        {
+            seedCandidates[seedStart] = numMatchesInWindow == numOrientationKmersPerSeed;
+            numMatchesInWindow -= orientationKmerMatches[seedStart];
+        }
     }
-    else if (predictedOrientation == OrientationPrediction::kDoesNotAlign)
+
+    return seedCandidates;
+}
+
+// Reverse-complements the read if needed; returns false if the read is not expected to align
+bool LocusAligner::orient(Read& read, std::vector<bool>& kmerMatches) const
+{
+    OrientationPrediction predictedOrientation = orientationPredictor_.predict(read.sequence(), kmerMatches);
+
+    if (predictedOrientation == OrientationPrediction::kAlignsInReverseComplementOrientation)
     {
-        return {};
+        read.reverseComplement();
     }
 
-    auto readAligns = aligner_.align(read.sequence(), alignerSelector);
+    return predictedOrientation != OrientationPrediction::kDoesNotAlign;
+}
+
+LocusAligner::OptionalAlign LocusAligner::align(
+    const Read& read, const std::vector<bool>& kmerMatches, graphtools::AlignerSelector& alignerSelector) const
+{
+    // Orientation kmers absent from the graph rule out seeds that contain them
+    const std::vector<bool> seedCandidates
+        = getSeedCandidates(kmerMatches, orientationPredictor_.kmerLength(), seedKmerLength_);
+    auto readAligns = seedCandidates.empty() ? aligner_.align(read.sequence(), alignerSelector)
+                                             : aligner_.align(read.sequence(), alignerSelector, seedCandidates);
     if (readAligns.empty())
     {
         return {};
@@ -22,9 +22,11 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <boost/optional.hpp>
 
+#include "alignment/FlankKmerIndex.hh"
 #include "alignment/OrientationPredictor.hh"
 #include "core/Parameters.hh"
 #include "core/Read.hh"
@@ -38,6 +40,18 @@ namespace ehunter
 namespace locus
 {
 
+/// Numbers of read pairs processed by a LocusAligner, by the stage at which each pair was resolved
+struct LocusAlignerStats
+{
+    /// Neither mate shares enough kmers with the graph to be aligned
+    int numPairsRejectedByOrientation = 0;
+    /// Flank kmers shared with the graph cannot account for the minimal non-repeat alignment score
+    int numPairsRejectedByFlankKmers = 0;
+    /// The non-repeat score of the full alignments is too low
+    int numPairsRejectedByAlignmentScore = 0;
+    int numPairsAligned = 0;
+};
+
 class LocusAligner
 {
 public:
@@ -49,25 +63,35 @@ public:
     using AlignmentBufferPtr = std::shared_ptr<AlignmentBuffer>;
 
     ///
-    /// \param[in] buffer Buffer to store all locus reads for downstream analysis. This is only needed in specialized
-    /// calling scenarios. Buffering is skipped with this is null.
+    /// \param[in] alignmentBuffer Receiver of all locus read alignments for downstream analysis. This is only needed in
+    /// specialized calling scenarios. Buffering is skipped when this is null.
     ///
     LocusAligner(
         std::string locusId, GraphPtr graph, const HeuristicParameters& params, AlignmentWriterPtr writer,
-        AlignmentBufferPtr buffer);
+        AlignmentBufferPtr alignmentBuffer);
 
     /// \param[in,out] alignerSelector A per-thread alignment workspace which mutates during alignment
     ///
+    /// Read pairs are processed in stages of increasing cost and each stage can reject the pair: orientation
+    /// prediction, a bound on the non-repeat score from flank kmers, and full alignment followed by the non-repeat
+    /// score check
     AlignedPair align(Read& read, Read* mate, graphtools::AlignerSelector& alignerSelector);
 
+    const LocusAlignerStats& stats() const { return stats_; }
+
 private:
-    OptionalAlign align(Read& read, graphtools::AlignerSelector& alignerSelector) const;
+    bool orient(Read& read, std::vector<bool>& kmerMatches) const;
+    OptionalAlign
+    align(const Read& read, const std::vector<bool>& kmerMatches, graphtools::AlignerSelector& alignerSelector) const;
 
     std::string locusId_;
+    int seedKmerLength_;
     graphtools::GappedGraphAligner aligner_;
     OrientationPredictor orientationPredictor_;
+    FlankKmerIndex flankKmerIndex_;
     AlignmentWriterPtr writer_;
     AlignmentBufferPtr alignmentBuffer_;
+    LocusAlignerStats stats_;
 };
 
 }
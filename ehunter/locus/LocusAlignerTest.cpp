@@ -95,3 +95,27 @@ TEST(AligningReads, NotLocallyPlasedReads_NotAligned)
     ASSERT_FALSE(alignedPair.first);
     ASSERT_FALSE(alignedPair.second);
 }
+
+TEST(AligningReads, ReadPairsRejectedAtDifferentStages_RejectionsCounted)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("ATATTA(C)*GGCGGC"));
+    auto aligner = makeStrAligner(&graph);
+    graphtools::AlignerSelector selector(graphtools::AlignerType::DAG_ALIGNER);
+
+    Read read(ReadId("frag1", MateNumber::kFirstMate), "ATTACC", true);
+    Read mate(ReadId("frag1", MateNumber::kSecondMate), "GGCGGC", true);
+    aligner.align(read, &mate, selector);
+
+    Read unrelatedRead(ReadId("frag2", MateNumber::kFirstMate), "TTTTTT", true);
+    Read unrelatedMate(ReadId("frag2", MateNumber::kSecondMate), "AAAAAA", true);
+    aligner.align(unrelatedRead, &unrelatedMate, selector);
+
+    Read repeatRead(ReadId("frag3", MateNumber::kFirstMate), "CCCCCC", true);
+    Read repeatMate(ReadId("frag3", MateNumber::kSecondMate), "CCCCCC", true);
+    aligner.align(repeatRead, &repeatMate, selector);
+
+    const LocusAlignerStats& stats = aligner.stats();
+    EXPECT_EQ(1, stats.numPairsAligned);
+    EXPECT_EQ(1, stats.numPairsRejectedByOrientation);
+    EXPECT_EQ(1, stats.numPairsRejectedByFlankKmers);
+}
@@ -23,6 +23,8 @@
 
 #include <boost/smart_ptr/make_unique.hpp>
 
+#include "spdlog/spdlog.h"
+
 #include "locus/LocusAligner.hh"
 #include "locus/RFC1MotifAnalysis.hh"
 #include "locus/RepeatAnalyzer.hh"
@@ -43,8 +45,8 @@ namespace locus
 
 LocusAnalyzer::LocusAnalyzer(LocusSpecification locusSpec, const HeuristicParameters& params, AlignWriterPtr writer)
     : locusSpec_(std::move(locusSpec))
-    , alignmentBuffer_(locusSpec_.useRFC1MotifAnalysis() ? std::make_shared<locus::AlignmentBuffer>() : nullptr)
-    , aligner_(locusSpec_.locusId(), &locusSpec_.regionGraph(), params, std::move(writer), alignmentBuffer_)
+    , motifAccumulator_(locusSpec_.useRFC1MotifAnalysis() ? std::make_shared<RFC1MotifAccumulator>() : nullptr)
+    , aligner_(locusSpec_.locusId(), &locusSpec_.regionGraph(), params, std::move(writer), motifAccumulator_)
     , statsCalc_(locusSpec_.typeOfChromLocusLocatedOn(), locusSpec_.regionGraph())
 {
     for (const auto& variantSpec : locusSpec_.variantSpecs())
@@ -156,8 +158,14 @@ void LocusAnalyzer::processOfftargetMates(const Read& read, const Read& mate)
     }
 }
 
-LocusFindings LocusAnalyzer::analyze(Sex sampleSex, boost::optional<double> genomeWideDepth)
+LocusFindings LocusAnalyzer::analyze(Sex sampleSex, boost::optional<double> genomeWideDepth, int threadCount)
 {
+    const LocusAlignerStats& alignerStats = aligner_.stats();
+    spdlog::debug(
+        "Read pairs at {}: {} aligned; rejected {} by orientation, {} by flank kmers, {} by alignment score",
+        locusId(), alignerStats.numPairsAligned, alignerStats.numPairsRejectedByOrientation,
+        alignerStats.numPairsRejectedByFlankKmers, alignerStats.numPairsRejectedByAlignmentScore);
+
     LocusFindings locusFindings(statsCalc_.estimate(sampleSex));
     if (genomeWideDepth && locusSpec_.requiresGenomeWideDepth())
     {
@@ -166,7 +174,8 @@ LocusFindings LocusAnalyzer::analyze(Sex sampleSex, boost::optional<double> geno
 
     for (auto& variantAnalyzer : variantAnalyzers_)
     {
-        std::unique_ptr<VariantFindings> variantFindingsPtr = variantAnalyzer->analyze(locusFindings.stats);
+        std::unique_ptr<VariantFindings> variantFindingsPtr
+            = variantAnalyzer->analyze(locusFindings.stats, threadCount);
         const string& variantId = variantAnalyzer->variantId();
         locusFindings.findingsForEachVariant.emplace(variantId, std::move(variantFindingsPtr));
     }
@@ -174,8 +183,8 @@ LocusFindings LocusAnalyzer::analyze(Sex sampleSex, boost::optional<double> geno
     // Run RFC1 caller if required for this locus:
     if (locusSpec().useRFC1MotifAnalysis())
     {
-        assert(alignmentBuffer_);
-        runRFC1MotifAnalysis(*alignmentBuffer_, locusFindings);
+        assert(motifAccumulator_);
+        runRFC1MotifAnalysis(*motifAccumulator_, locusFindings);
     }
 
     return locusFindings;
@@ -200,9 +209,11 @@ void LocusAnalyzer::addSmallVariantAnalyzer(
 void LocusAnalyzer::runVariantAnalysis(
     const Read& read, const LocusAnalyzer::Align& readAlign, const Read& mate, const LocusAnalyzer::Align& mateAlign)
 {
+    const AlignmentScoreSummary readSummary(readAlign);
+    const AlignmentScoreSummary mateSummary(mateAlign);
     for (auto& analyzer : variantAnalyzers_)
     {
-        analyzer->processMates(read, readAlign, mate, mateAlign);
+        analyzer->processMates(read, readSummary, mate, mateSummary);
     }
 }
 
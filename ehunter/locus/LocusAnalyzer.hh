@@ -33,11 +33,11 @@
 #include "core/GenomicRegion.hh"
 #include "core/LocusStats.hh"
 #include "core/Read.hh"
-#include "locus/AlignmentBuffer.hh"
 #include "locus/IrrPairFinder.hh"
 #include "locus/LocusAligner.hh"
 #include "locus/LocusFindings.hh"
 #include "locus/LocusSpecification.hh"
+#include "locus/RFC1MotifAnalysis.hh"
 #include "locus/VariantAnalyzer.hh"
 
 namespace ehunter
@@ -67,9 +67,11 @@ public:
 
     const std::string& locusId() const { return locusSpec_.locusId(); }
     const LocusSpecification& locusSpec() const { return locusSpec_; }
+    const LengthStats& fragLengthStats() const { return statsCalc_.fragLengthStats(); }
 
     void processMates(Read& read, Read* mate, RegionType regionType, graphtools::AlignerSelector& alignerSelector);
-    LocusFindings analyze(Sex sampleSex, boost::optional<double> genomeWideDepth);
+    /// \param[in] threadCount Number of threads available to genotype variants supported by very many fragments
+    LocusFindings analyze(Sex sampleSex, boost::optional<double> genomeWideDepth, int threadCount = 1);
 
     const boost::optional<IrrPairFinder>& irrPairFinder() const { return irrPairFinder_; }
     void addIrrPairFinder(std::string motif);
@@ -85,8 +87,8 @@ private:
 
     LocusSpecification locusSpec_;
 
-    // Read alignments are optionally buffered for custom additional analysis at certain loci
-    std::shared_ptr<locus::AlignmentBuffer> alignmentBuffer_;
+    // Repeat motif evidence is optionally accumulated for custom additional analysis at certain loci
+    std::shared_ptr<RFC1MotifAccumulator> motifAccumulator_;
 
     LocusAligner aligner_;
     LocusStatsCalculator statsCalc_;
@@ -27,10 +27,8 @@
 #include "boost/algorithm/string.hpp"
 #include "boost/optional.hpp"
 #include "boost/range/adaptor/map.hpp"
-#include "boost/range/numeric.hpp"
 
 #include "graphalign/GraphAlignment.hh"
-#include "locus/AlignmentBuffer.hh"
 #include "locus/RFC1MotifAnalysisUtil.hh"
 #include "locus/RFC1Status.hh"
 
@@ -102,375 +100,89 @@ std::vector<unsigned> getAlleleRepeatMotifCounts(const RepeatFindings& repeatFin
 std::vector<uint8_t> getBinaryQuals(const std::string& read)
 {
     std::vector<uint8_t> binaryQuals(read.size());
-    std::transform(read.begin(), read.end(), binaryQuals.begin(), [](unsigned char c) { return std::isupper(c); });
+    std::transform(read.begin(), read.end(), binaryQuals.begin(), [](unsigned char c) { return std::isupper(c) != 0; });
     return binaryQuals;
 }
 
-using MotifsWithQualWeight_t = std::vector<std::pair<std::string, double>>;
-
-/// \brief Given a single EH alignment record, return all repeat motifs with quality information
-///
-/// All motifs are found and reported in the read's alignment orientation
+/// \brief Test if the read is a spanning read for the RFC1 locus
 ///
-/// \param[in] binaryQuals Quality vector for the read, reduced to 2 {low, high} quality states
-///
-/// \param[in] usableBaseRange 0-indexed, closed interval representing the usable portion of the read in read alignment
-/// coordinates, or none. If none, the entire read is considered usable.
+/// To be counted, spanning reads must overlap with both left and right flanks by a sufficient amount and also meet
+/// quality criteria.
 ///
-/// \param[in] expectedMotifSize Size of the repeat motif at the target locus
+/// \param[in] nodeAlignmentLengths Total aligned length of the read to each graph node
 ///
-/// \return A vector of motif data. Each vector element is a 2-tuple containing the motif string and its quality weight.
-/// The quality weight is the fraction of high-quality bases in the motif.
+/// \param[in] binaryQuals Quality vector for the read, reduced to 2 {low, high} quality states
 ///
-MotifsWithQualWeight_t getAllMotifsWithQualWeight(
-    const locus::AlignmentBufferData& alignmentData, const std::vector<uint8_t>& binaryQuals,
-    boost::optional<std::pair<unsigned, unsigned>> usableBaseRange, const unsigned expectedMotifSize)
+bool isSpanningRead(const std::vector<unsigned>& nodeAlignmentLengths, const std::vector<uint8_t>& binaryQuals)
 {
-    // A motif most be found at least this far from the edge of a read for it to be counted
-    static const unsigned minDistFromReadEdge(1);
-
-    const unsigned readLength(binaryQuals.size());
-
-    // Get the first and last positions in read coordinates from which a repeat motif can be extracted
-    // (zero-indexed, closed)
-    const auto repeatExtractionRange
-        = std::make_pair(minDistFromReadEdge, readLength - (expectedMotifSize + minDistFromReadEdge));
-
-    auto isValidMotifCandidate = [&](const unsigned readPos) -> bool
-    {
-        // Exclude motifs in low-quality regions of the read:
-        if (usableBaseRange)
-        {
-            if ((readPos < usableBaseRange->first) or ((readPos + expectedMotifSize - 1) > usableBaseRange->second))
-            {
-                return false;
-            }
-        }
-
-        // Skip repeats occurring at the start or end of the read
-        if ((readPos < repeatExtractionRange.first) or (readPos > repeatExtractionRange.second))
-        {
-            return false;
-        }
-
-        return true;
-    };
-
-    const auto read(boost::to_upper_copy<std::string>(alignmentData.read));
+    // To count as spanning reads, each flank alignment should be at least this long
+    static const int minFlankLength(10);
 
-    // Get the first and last usable positions in read coordinates of the repeat tract (zero-indexed, closed)
+    // To count as spanning reads, each flank alignment should have at least this fraction of high quality bases
     //
-    // Note that the first and last repeat units in the tract are not used (presumably to reduce motif noise?)
-    auto repeatTractRange(std::make_pair(0, readLength - 1));
+    // This is tested over twice the minFlankLength
+    static const double minFlankHighQBaseFraction(0.7);
 
-    const auto nodeAlignmentLengths = getGraphNodeAlignmentLengths(alignmentData.readAlignment);
-    if ((nodeAlignmentLengths.size() > 0) and (nodeAlignmentLengths[0] != 0))
-    {
-        repeatTractRange.first += nodeAlignmentLengths[0] + expectedMotifSize;
-    }
-    if ((nodeAlignmentLengths.size() > 2) and (nodeAlignmentLengths[2] != 0))
+    // Require that the read aligns to both flanks and the repeat:
+    if ((nodeAlignmentLengths.size() < 3)
+        or (std::any_of(
+            nodeAlignmentLengths.begin(), nodeAlignmentLengths.end(), [](unsigned i) { return (i == 0); })))
     {
-        repeatTractRange.second -= nodeAlignmentLengths[2] + expectedMotifSize;
+        return false;
     }
 
-    std::vector<std::pair<std::string, double>> motifData;
-    for (unsigned readPos(repeatTractRange.first); readPos < (repeatTractRange.second + 1);
-         readPos += expectedMotifSize)
+    auto isBadFlank = [&](const int cstart, const int cstop) -> bool
     {
-        if (isValidMotifCandidate(readPos))
+        const int span(cstop - cstart);
+        if (span < minFlankLength)
         {
-            const auto motifStr(read.substr(readPos, expectedMotifSize));
-            const auto qiter(binaryQuals.begin() + readPos);
-            const double motifQualWeight = mean(qiter, qiter + expectedMotifSize);
-            motifData.emplace_back(getMinRotation(motifStr), motifQualWeight);
+            return true;
         }
-    }
-
-    return motifData;
-}
-
-using MotifCountMap_t = std::map<std::string, unsigned>;
-
-/// \brief Iterate over reads from the RFC1 locus and count high quality repeat motif observations
-///
-/// \param[in] expectedMotifSize Size of the repeat motif at the target locus
-///
-/// \param[in] minRepeatMotifSpan The minimum number of repeat units which must be spanned by a read alignment for the
-/// read to be used as evidence
-///
-/// \return A map from high-quality motif strings to the number of times the motif has been observed in the target STR
-/// region
-///
-MotifCountMap_t getHighQMotifMap(
-    const locus::AlignmentBuffer& alignmentBuffer, const unsigned expectedMotifSize, const unsigned minRepatMotifSpan)
-{
-    // Only include motifs with a motif quality weight at least this high, where the motif quality weight is the
-    // fraction of motif bases that are quantized as the "high quality" state.
-    static const double minMotifQualWeight(1.0);
+        const auto qiter(binaryQuals.begin() + cstart);
+        const double highQBaseFraction = mean(qiter, qiter + span);
+        return (highQBaseFraction < minFlankHighQBaseFraction);
+    };
 
-    MotifCountMap_t highQMotifMap;
-    for (const auto& alignmentData : alignmentBuffer.getBuffer())
+    // Check left flank quality
     {
-        // Only look at reads which align to the repeat unit at least minRepeatMotifSpan times:
-        if (getRepeatMotifSpan(alignmentData.readAlignment) < minRepatMotifSpan)
+        const int cstop(nodeAlignmentLengths[0]);
+        const int cstart(std::max(0, cstop - minFlankLength * 2));
+        if (isBadFlank(cstart, cstop))
         {
-            continue;
-        }
-
-        const auto binaryQuals = getBinaryQuals(alignmentData.read);
-        const auto usableBaseRange = findUsableReadBaseRange(binaryQuals, alignmentData.isReversed);
-        if (not usableBaseRange)
-        {
-            continue;
-        }
-
-        const auto motifData
-            = getAllMotifsWithQualWeight(alignmentData, binaryQuals, usableBaseRange, expectedMotifSize);
-
-        for (const auto& elem : motifData)
-        {
-            if (elem.second >= minMotifQualWeight)
-            {
-                highQMotifMap[elem.first] += 1;
-            }
+            return false;
         }
     }
 
-    return highQMotifMap;
-}
-
-/// \brief Observation data for a given motif
-///
-struct MotifObservations
-{
-    /// Total motif observation count
-    unsigned count = 0;
-
-    /// Total quality-weighted motif observation count
-    double weightedCount = 0.;
-
-    /// Fraction of total quality-weighted motif observation count over all motifs
-    double weightedFrac = 0.;
-};
-
-using MotifObservationMap_t = std::map<std::string, MotifObservations>;
-
-/// \brief Summary data on all high-quality repeat motif observations, as well as the fraction of pathogenic motifs per
-/// read.
-///
-struct MotifAndPurityData
-{
-    /// A map from high quality repeat motifs to motif observation data
-    MotifObservationMap_t motifMap;
-
-    /// For each read, contains the fraction of pathogenic motifs compared to all other high-quality repeat motifs in
-    /// the read
-    std::vector<double> pathogenicMotifFractionPerRead;
-};
-
-using HighQMotif_t = std::set<std::string>;
-
-/// \brief Find set of high quality motifs at the RFC1 locus
-///
-/// \param[in] expectedMotifSize: Size of the repeat motif at the target locus
-///
-/// \param[in] minRepeatMotifSpan The minimum number of repeat units which must be spanned by a read alignment for the
-/// read to be used as evidence
-///
-HighQMotif_t gethighQMotifs(
-    const locus::AlignmentBuffer& alignmentBuffer, const unsigned expectedMotifSize, const unsigned minRepeatMotifSpan)
-{
-    // A motif must have at least this many high-quality observations before it is included in the highQ motif set
-    static const unsigned minHighQMotifObservations(2);
-
-    const auto highQMotifMap = getHighQMotifMap(alignmentBuffer, expectedMotifSize, minRepeatMotifSpan);
-
-    HighQMotif_t highQMotifs;
-    for (const auto& elem : highQMotifMap)
+    // Check right flank quality
     {
-        const auto& highQMotif(elem.first);
-        const auto count(elem.second);
-        if ((highQMotif.size() == expectedMotifSize) and (count >= minHighQMotifObservations))
+        const int cstart(nodeAlignmentLengths[0] + nodeAlignmentLengths[1]);
+        const int readLength(binaryQuals.size());
+        const int cstop(std::min(readLength, cstart + minFlankLength * 2));
+        if (isBadFlank(cstart, cstop))
         {
-            highQMotifs.insert(highQMotif);
+            return false;
         }
     }
 
-    return highQMotifs;
+    return true;
 }
 
-/// \brief Return the total pathogenic motif observations
-///
-/// \param[in] readMotifCount Count of motif observations
-///
-/// \param[in] pathogenicMotifs Container of pathogenic motif strings
-///
-unsigned getPathogenicMotifTotal(
-    const std::map<std::string, unsigned> readMotifCount, const std::vector<std::string>& pathogenicMotifs)
-{
-    unsigned total(0);
-    for (const auto& pathogenicMotif : pathogenicMotifs)
-    {
-        const auto citer(readMotifCount.find(pathogenicMotif));
-        if (citer != readMotifCount.end())
-        {
-            total += citer->second;
-        }
-    }
-    return total;
-}
-
-/// \brief Get MotifAndPurityData from RFC1 locus reads
-///
-/// \param[in] expectedMotifSize: Size of the repeat motif at the target locus
-///
-/// \param[in] minRepeatMotifSpan The minimum number of repeat units which must be spanned by a read alignment for the
-/// read to be used as evidence
-///
-/// \param[in] pathogenicMotifs Container of pathogenic motif strings
-///
-MotifAndPurityData getMotifAndPurityData(
-    const locus::AlignmentBuffer& alignmentBuffer, const unsigned expectedMotifSize, const unsigned minRepatMotifSpan,
-    const std::vector<std::string>& pathogenicMotifs)
+/// Rotation table of all ACGT motifs of the RFC1 motif size
+const KmerRotationTable& getMotifRotationTable()
 {
-    // For a read to be counted in the pathogen_purities list, at least this many repeat motifs must be processed from
-    // the read alignment
-    static const unsigned minPurityMotifCountsPerRead(5);
-
-    const auto highQMotifs(gethighQMotifs(alignmentBuffer, expectedMotifSize, minRepatMotifSpan));
-
-    MotifAndPurityData mpData;
-
-    for (const auto& alignmentData : alignmentBuffer.getBuffer())
-    {
-        // Only look at reads which align to the repeat unit at least minRepeatMotifSpan times:
-        if (getRepeatMotifSpan(alignmentData.readAlignment) < minRepatMotifSpan)
-        {
-            continue;
-        }
-
-        const auto binaryQuals = getBinaryQuals(alignmentData.read);
-        const auto motifData = getAllMotifsWithQualWeight(alignmentData, binaryQuals, {}, expectedMotifSize);
-
-        std::map<std::string, unsigned> readMotifCount;
-        for (const auto& elem : motifData)
-        {
-            const auto& motifSeq(elem.first);
-            const auto motifQualWeight(elem.second);
-            if (highQMotifs.find(motifSeq) != highQMotifs.end())
-            {
-                mpData.motifMap[motifSeq].count += 1;
-                mpData.motifMap[motifSeq].weightedCount += motifQualWeight;
-                readMotifCount[motifSeq] += 1;
-            }
-        }
-
-        const unsigned readMotifTotal = boost::accumulate(readMotifCount | boost::adaptors::map_values, 0u);
-        if (readMotifTotal >= minPurityMotifCountsPerRead)
-        {
-            const unsigned pathogenicMotifTotal(getPathogenicMotifTotal(readMotifCount, pathogenicMotifs));
-            if (pathogenicMotifTotal > 0)
-            {
-                mpData.pathogenicMotifFractionPerRead.push_back(safeFrac(pathogenicMotifTotal, readMotifTotal));
-            }
-        }
-    }
-
-    double totalWeightedCount(0);
-    for (auto& v : mpData.motifMap | boost::adaptors::map_values)
-    {
-        totalWeightedCount += v.weightedCount;
-    }
-    for (auto& v : mpData.motifMap | boost::adaptors::map_values)
-    {
-        v.weightedFrac = v.weightedCount / totalWeightedCount;
-    }
-
-    return mpData;
-}
-
-/// \brief Count number of spanning reads for RFC1 locus.
-///
-/// To be counted, spanning reads must overlap with both left and right flanks by a sufficient amount and also meet
-/// quality criteria.
-///
-/// \return Spanning read count
-///
-unsigned countSpanningReads(const locus::AlignmentBuffer& alignmentBuffer)
-{
-    // To count as spanning reads, each flank alignment should be at least this long
-    static const int minFlankLength(10);
-
-    // To count as spanning reads, each flank alignment should have at least this fraction of high quality bases
-    //
-    // This is tested over twice the minFlankLength
-    static const double minFlankHighQBaseFraction(0.7);
-
-    unsigned numSpanningReads(0);
-    for (const auto& alignmentData : alignmentBuffer.getBuffer())
-    {
-        const auto nodeAlignmentLengths = getGraphNodeAlignmentLengths(alignmentData.readAlignment);
-
-        // Require that the read aligns to both flanks and the repeat:
-        if ((nodeAlignmentLengths.size() < 3)
-            or (std::any_of(
-                nodeAlignmentLengths.begin(), nodeAlignmentLengths.end(), [](unsigned i) { return (i == 0); })))
-        {
-            continue;
-        }
-
-        const auto binaryQuals = getBinaryQuals(alignmentData.read);
-
-        auto isBadFlank = [&](const int cstart, const int cstop) -> bool
-        {
-            const int span(cstop - cstart);
-            if (span < minFlankLength)
-            {
-                return true;
-            }
-            const auto qiter(binaryQuals.begin() + cstart);
-            const double highQBaseFraction = mean(qiter, qiter + span);
-            return (highQBaseFraction < minFlankHighQBaseFraction);
-        };
-
-        // Check left flank quality
-        {
-            const int cstop(nodeAlignmentLengths[0]);
-            const int cstart(std::max(0, cstop - minFlankLength * 2));
-            if (isBadFlank(cstart, cstop))
-            {
-                continue;
-            }
-        }
-
-        // Check right flank quality
-        {
-            const int cstart(nodeAlignmentLengths[0] + nodeAlignmentLengths[1]);
-            const int readLength(binaryQuals.size());
-            const int cstop(std::min(readLength, cstart + minFlankLength * 2));
-            if (isBadFlank(cstart, cstop))
-            {
-                continue;
-            }
-        }
-
-        numSpanningReads += 1;
-    }
-
-    return numSpanningReads;
+    static const KmerRotationTable rotationTable(RFC1MotifAccumulator::kExpectedMotifSize);
+    return rotationTable;
 }
 
 /// \brief Get MotifAndPurityData from RFC1 locus reads, but attempting to exclude spanning reads
 ///
 /// \param[in] alleleRepeatMotifCounts RFC1 repeat counts for each allele of the sample as predicted by ExpansionHunter
 ///
-/// \param[in] expectedMotifSize: Size of the repeat motif at the target locus
-///
 /// \param[in] pathogenicMotifs Container of pathogenic motif strings
 ///
 MotifAndPurityData getMotifAndPurityDataNoSpan(
-    const locus::AlignmentBuffer& alignmentBuffer, const std::vector<unsigned>& alleleRepeatMotifCounts,
-    const unsigned expectedMotifSize, const std::vector<std::string>& pathogenicMotifs)
+    const RFC1MotifAccumulator& motifAccumulator, const std::vector<unsigned>& alleleRepeatMotifCounts,
+    const std::vector<std::string>& pathogenicMotifs)
 {
     // If both alleles are predicted to be expanded by EH, then this is the min number of repeats the read must span to
     // be considered 'non-spanning' evidence.
@@ -487,7 +199,7 @@ MotifAndPurityData getMotifAndPurityDataNoSpan(
     //
     const unsigned minRepeatMotifSpan = std::min(minAlleleRepeatMotifCount, predefinedShortRepeatMotifCount) + 2;
 
-    return getMotifAndPurityData(alignmentBuffer, expectedMotifSize, minRepeatMotifSpan, pathogenicMotifs);
+    return motifAccumulator.getMotifAndPurityData(minRepeatMotifSpan, pathogenicMotifs);
 }
 
 /// Loci where EH predicts at least one allele where the motif count is at least this long are treated as expanded
@@ -685,14 +397,218 @@ RFC1Status getRFC1Status(
 
 }
 
-void runRFC1MotifAnalysis(const locus::AlignmentBuffer& alignmentBuffer, LocusFindings& locusFindings)
+const unsigned RFC1MotifAccumulator::kExpectedMotifSize;
+const unsigned RFC1MotifAccumulator::kMaxMinRepeatMotifSpan;
+const unsigned RFC1MotifAccumulator::kNumRepeatMotifSpanBins;
+
+void RFC1MotifAccumulator::testAndAddRead(
+    const std::string& read, const bool isReversed, const graphtools::GraphAlignment& readAlignment)
+{
+    // For now just check that the read touches the repeat at all
+    const unsigned repeatMotifSpan(getRepeatMotifSpan(readAlignment));
+    if (repeatMotifSpan == 0)
+    {
+        return;
+    }
+
+    const auto binaryQuals = getBinaryQuals(read);
+    const auto nodeAlignmentLengths = getGraphNodeAlignmentLengths(readAlignment);
+    if (isSpanningRead(nodeAlignmentLengths, binaryQuals))
+    {
+        numSpanningReads_ += 1;
+    }
+
+    // Usable bases of the read; only motifs in this range can be counted as high-quality observations
+    const auto usableBaseRange = findUsableReadBaseRange(binaryQuals, isReversed);
+
+    // A motif must be found at least this far from the edge of a read for it to be counted
+    static const unsigned minDistFromReadEdge(1);
+
+    const unsigned readLength(binaryQuals.size());
+
+    // Get the first and last positions in read coordinates from which a repeat motif can be extracted
+    // (zero-indexed, closed)
+    const auto repeatExtractionRange
+        = std::make_pair(minDistFromReadEdge, readLength - (kExpectedMotifSize + minDistFromReadEdge));
+
+    // Get the first and last usable positions in read coordinates of the repeat tract (zero-indexed, closed)
+    //
+    // Note that the first and last repeat units in the tract are not used (presumably to reduce motif noise?)
+    auto repeatTractRange(std::make_pair(0, readLength - 1));
+
+    if ((nodeAlignmentLengths.size() > 0) and (nodeAlignmentLengths[0] != 0))
+    {
+        repeatTractRange.first += nodeAlignmentLengths[0] + kExpectedMotifSize;
+    }
+    if ((nodeAlignmentLengths.size() > 2) and (nodeAlignmentLengths[2] != 0))
+    {
+        repeatTractRange.second -= nodeAlignmentLengths[2] + kExpectedMotifSize;
+    }
+
+    const unsigned repeatMotifSpanBin(std::min(repeatMotifSpan, kMaxMinRepeatMotifSpan));
+    for (unsigned readPos(repeatTractRange.first); readPos < (repeatTractRange.second + 1);
+         readPos += kExpectedMotifSize)
+    {
+        // Skip repeats occurring at the start or end of the read
+        if ((readPos < repeatExtractionRange.first) or (readPos > repeatExtractionRange.second))
+        {
+            continue;
+        }
+
+        const unsigned motifId(getMotifId(read, readPos));
+        const auto qiter(binaryQuals.begin() + readPos);
+        const unsigned highQBaseCount(std::accumulate(qiter, qiter + kExpectedMotifSize, 0u));
+
+        MotifTally& motifTally(motifTallies_[motifId][repeatMotifSpanBin]);
+        motifTally.count += 1;
+        motifTally.highQBaseCount += highQBaseCount;
+
+        const bool isInUsableBaseRange = usableBaseRange and (readPos >= usableBaseRange->first)
+            and ((readPos + kExpectedMotifSize - 1) <= usableBaseRange->second);
+        if (isInUsableBaseRange and (highQBaseCount == kExpectedMotifSize))
+        {
+            motifTally.highQCount += 1;
+        }
+
+        readMotifIds_.push_back(motifId);
+    }
+
+    reads_.push_back({ repeatMotifSpanBin, static_cast<unsigned>(readMotifIds_.size()) });
+}
+
+unsigned RFC1MotifAccumulator::getMotifId(const std::string& read, const unsigned readPos)
+{
+    const KmerRotationTable& rotationTable(getMotifRotationTable());
+    const auto kmerCode(rotationTable.encode(read, readPos));
+    if (not kmerCode)
+    {
+        return getMotifId(boost::to_upper_copy(read.substr(readPos, kExpectedMotifSize)));
+    }
+
+    int& motifId(kmerCodeToMotifId_[*kmerCode]);
+    if (motifId < 0)
+    {
+        motifId = getMotifId(rotationTable.decode(rotationTable.getMinRotationCode(*kmerCode)));
+    }
+    return motifId;
+}
+
+unsigned RFC1MotifAccumulator::getMotifId(const std::string& readMotif)
+{
+    const auto readMotifIter(readMotifToMotifId_.find(readMotif));
+    if (readMotifIter != readMotifToMotifId_.end())
+    {
+        return readMotifIter->second;
+    }
+
+    // A minimal rotation is its own minimal rotation, so known motifs are found among the read motifs
+    const std::string motif(getMinRotation(readMotif));
+    const auto motifIter(readMotifToMotifId_.find(motif));
+    unsigned motifId(motifs_.size());
+    if (motifIter != readMotifToMotifId_.end())
+    {
+        motifId = motifIter->second;
+    }
+    else
+    {
+        motifs_.push_back(motif);
+        motifTallies_.emplace_back();
+        readMotifToMotifId_.emplace(motif, motifId);
+    }
+
+    readMotifToMotifId_.emplace(readMotif, motifId);
+    return motifId;
+}
+
+MotifAndPurityData RFC1MotifAccumulator::getMotifAndPurityData(
+    const unsigned minRepeatMotifSpan, const std::vector<std::string>& pathogenicMotifs) const
+{
+    // A motif must have at least this many high-quality observations before it is included in the highQ motif set
+    static const unsigned minHighQMotifObservations(2);
+
+    // For a read to be counted in the pathogen_purities list, at least this many repeat motifs must be processed from
+    // the read alignment
+    static const unsigned minPurityMotifCountsPerRead(5);
+
+    assert(minRepeatMotifSpan <= kMaxMinRepeatMotifSpan);
+
+    MotifAndPurityData mpData;
+
+    const unsigned motifCount(motifs_.size());
+    std::vector<uint8_t> isHighQMotif(motifCount, false);
+    std::vector<uint8_t> isPathogenicMotif(motifCount, false);
+    for (unsigned motifId(0); motifId < motifCount; ++motifId)
+    {
+        const std::string& motif(motifs_[motifId]);
+        MotifTally motifTotal;
+        for (unsigned spanBin(minRepeatMotifSpan); spanBin < kNumRepeatMotifSpanBins; ++spanBin)
+        {
+            const MotifTally& motifTally(motifTallies_[motifId][spanBin]);
+            motifTotal.highQCount += motifTally.highQCount;
+            motifTotal.count += motifTally.count;
+            motifTotal.highQBaseCount += motifTally.highQBaseCount;
+        }
+
+        if ((motif.size() != kExpectedMotifSize) or (motifTotal.highQCount < minHighQMotifObservations))
+        {
+            continue;
+        }
+
+        isHighQMotif[motifId] = true;
+        isPathogenicMotif[motifId]
+            = (std::find(pathogenicMotifs.begin(), pathogenicMotifs.end(), motif) != pathogenicMotifs.end());
+
+        MotifObservations& motifObservations(mpData.motifMap[motif]);
+        motifObservations.count = motifTotal.count;
+        motifObservations.weightedCount = static_cast<double>(motifTotal.highQBaseCount) / kExpectedMotifSize;
+    }
+
+    unsigned motifIdsBegin(0);
+    for (const auto& readMotifs : reads_)
+    {
+        if (readMotifs.repeatMotifSpanBin >= minRepeatMotifSpan)
+        {
+            unsigned readMotifTotal(0);
+            unsigned pathogenicMotifTotal(0);
+            for (unsigned index(motifIdsBegin); index < readMotifs.motifIdsEnd; ++index)
+            {
+                const unsigned motifId(readMotifIds_[index]);
+                if (isHighQMotif[motifId])
+                {
+                    readMotifTotal += 1;
+                    pathogenicMotifTotal += isPathogenicMotif[motifId];
+                }
+            }
+
+            if ((readMotifTotal >= minPurityMotifCountsPerRead) and (pathogenicMotifTotal > 0))
+            {
+                mpData.pathogenicMotifFractionPerRead.push_back(safeFrac(pathogenicMotifTotal, readMotifTotal));
+            }
+        }
+        motifIdsBegin = readMotifs.motifIdsEnd;
+    }
+
+    double totalWeightedCount(0);
+    for (auto& v : mpData.motifMap | boost::adaptors::map_values)
+    {
+        totalWeightedCount += v.weightedCount;
+    }
+    for (auto& v : mpData.motifMap | boost::adaptors::map_values)
+    {
+        v.weightedFrac = v.weightedCount / totalWeightedCount;
+    }
+
+    return mpData;
+}
+
+void runRFC1MotifAnalysis(const RFC1MotifAccumulator& motifAccumulator, LocusFindings& locusFindings)
 {
     // Note that the 'use_rotation' and 'use_spanning' options from the proto version of this method are both fixed to
     // true here.
     //
 
     // Hard coded parameters for RFC1 locus:
-    static const unsigned expectedMotifSize(5);
+    static const unsigned expectedMotifSize(RFC1MotifAccumulator::kExpectedMotifSize);
     static const std::vector<std::string> pathogenicMotifs { "AAGGG", "ACAGG" };
 
     // RFC1 motif analysis loci are constrained to only one variant (this is enforced with an error message when loading
@@ -709,16 +625,14 @@ void runRFC1MotifAnalysis(const locus::AlignmentBuffer& alignmentBuffer, LocusFi
     // Get standard motif map (including any spanning reads)
     //
     static const unsigned standardMinRepeatMotifSpan(0);
-    const auto mpData
-        = getMotifAndPurityData(alignmentBuffer, expectedMotifSize, standardMinRepeatMotifSpan, pathogenicMotifs);
+    const auto mpData = motifAccumulator.getMotifAndPurityData(standardMinRepeatMotifSpan, pathogenicMotifs);
 
     // Get 'no-spanning' motif map (attempting to exclude spanning reads)
     //
     const std::vector<unsigned> alleleRepeatMotifCounts(getAlleleRepeatMotifCounts(repeatFindings));
-    const auto mpDataNoSpan
-        = getMotifAndPurityDataNoSpan(alignmentBuffer, alleleRepeatMotifCounts, expectedMotifSize, pathogenicMotifs);
+    const auto mpDataNoSpan = getMotifAndPurityDataNoSpan(motifAccumulator, alleleRepeatMotifCounts, pathogenicMotifs);
 
-    const unsigned numSpanningReads(countSpanningReads(alignmentBuffer));
+    const unsigned numSpanningReads(motifAccumulator.numSpanningReads());
     const RFC1Status rfc1Status = getRFC1Status(
         alleleRepeatMotifCounts, mpData, mpDataNoSpan, numSpanningReads, expectedMotifSize, pathogenicMotifs,
         readLength, averageDepth);
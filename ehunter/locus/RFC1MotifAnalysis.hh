@@ -21,21 +21,133 @@
 
 #pragma once
 
+#include <array>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "graphalign/GraphAlignment.hh"
 #include "locus/AlignmentBuffer.hh"
 #include "locus/LocusFindings.hh"
 
 namespace ehunter
 {
 
+/// \brief Observation data for a given motif
+///
+struct MotifObservations
+{
+    /// Total motif observation count
+    unsigned count = 0;
+
+    /// Total quality-weighted motif observation count
+    double weightedCount = 0.;
+
+    /// Fraction of total quality-weighted motif observation count over all motifs
+    double weightedFrac = 0.;
+};
+
+using MotifObservationMap_t = std::map<std::string, MotifObservations>;
+
+/// \brief Summary data on all high-quality repeat motif observations, as well as the fraction of pathogenic motifs per
+/// read.
+///
+struct MotifAndPurityData
+{
+    /// A map from high quality repeat motifs to motif observation data
+    MotifObservationMap_t motifMap;
+
+    /// For each read, contains the fraction of pathogenic motifs compared to all other high-quality repeat motifs in
+    /// the read
+    std::vector<double> pathogenicMotifFractionPerRead;
+};
+
+/// \brief Accumulates RFC1 repeat motif evidence from reads as they are aligned
+///
+/// Each read which overlaps the repeat is reduced to its repeat motif observations on arrival, so neither the read nor
+/// its alignment is stored. Motif counts are binned by the number of repeat units spanned by the read alignment, which
+/// allows read filters that depend on the final repeat genotype to be applied when the evidence is reduced.
+///
+/// Per read, only the identifiers of the observed motifs are kept. These are needed to find the fraction of pathogenic
+/// motifs in each read, which depends on the set of high-quality motifs observed over all reads.
+///
+class RFC1MotifAccumulator : public locus::AlignmentBuffer
+{
+public:
+    /// Size of the repeat motif at the RFC1 locus
+    static const unsigned kExpectedMotifSize = 5;
+
+    /// Largest minimum repeat unit span which can be requested when reducing motif evidence
+    static const unsigned kMaxMinRepeatMotifSpan = 15;
+
+    /// Test if the read overlaps the repeat, and if so, add its motif observations
+    void
+    testAndAddRead(const std::string& read, bool isReversed, const graphtools::GraphAlignment& readAlignment) override;
+
+    /// \brief Get MotifAndPurityData from RFC1 locus reads
+    ///
+    /// \param[in] minRepeatMotifSpan The minimum number of repeat units which must be spanned by a read alignment for
+    /// the read to be used as evidence
+    ///
+    /// \param[in] pathogenicMotifs Container of pathogenic motif strings
+    ///
+    MotifAndPurityData
+    getMotifAndPurityData(unsigned minRepeatMotifSpan, const std::vector<std::string>& pathogenicMotifs) const;
+
+    /// Count of spanning reads meeting flank length and quality criteria
+    unsigned numSpanningReads() const { return numSpanningReads_; }
+
+private:
+    static const unsigned kNumRepeatMotifSpanBins = kMaxMinRepeatMotifSpan + 1;
+
+    /// Observation counts of a motif from reads spanning the same number of repeat units
+    struct MotifTally
+    {
+        /// Count of observations entirely made of high-quality bases within the usable base range of the read
+        unsigned highQCount = 0;
+
+        /// Total observation count
+        unsigned count = 0;
+
+        /// Total count of high-quality bases over all observations
+        unsigned highQBaseCount = 0;
+    };
+
+    /// Observed motifs of a single read, stored in readMotifIds_ before index motifIdsEnd
+    struct ReadMotifs
+    {
+        unsigned repeatMotifSpanBin;
+        unsigned motifIdsEnd;
+    };
+
+    unsigned getMotifId(const std::string& read, unsigned readPos);
+    unsigned getMotifId(const std::string& readMotif);
+
+    // Motifs in their minimal rotation, indexed by motif id
+    std::vector<std::string> motifs_;
+    // Motif ids of ACGT motifs as they appear in reads indexed by kmer code, or -1 for motifs not observed yet
+    std::vector<int> kmerCodeToMotifId_ = std::vector<int>(1u << (2 * kExpectedMotifSize), -1);
+    // Motif ids of minimal rotations and of motifs with other bases as they appear in reads
+    std::unordered_map<std::string, unsigned> readMotifToMotifId_;
+    // Motif tallies for each repeat unit span of the read alignment, indexed by motif id
+    std::vector<std::array<MotifTally, kNumRepeatMotifSpanBins>> motifTallies_;
+
+    std::vector<ReadMotifs> reads_;
+    std::vector<unsigned> readMotifIds_;
+
+    unsigned numSpanningReads_ = 0;
+};
+
 /// \brief Analyze the RFC1 locus motif pattern with respect to motif expansions associated with CANVAS
 ///
 /// RFC1 locus call information are added to LocusFindings for inclusion in EH json output.
 ///
-/// \param[in] alignmentBuffer
+/// \param[in] motifAccumulator Motif evidence from all reads aligned to the locus
 ///
 /// \param[in,out] locusFindings Findings from conventional repeat expansion analysis of RFC1. Additional RFC1 motif
 /// analysis is added to this object for reporting downstream in the EH json output.
 ///
-void runRFC1MotifAnalysis(const locus::AlignmentBuffer& alignmentBuffer, LocusFindings& locusFindings);
+void runRFC1MotifAnalysis(const RFC1MotifAccumulator& motifAccumulator, LocusFindings& locusFindings);
 
 }
@@ -22,6 +22,7 @@
 #include "RFC1MotifAnalysisUtil.hh"
 
 #include <algorithm>
+#include <stdexcept>
 
 namespace ehunter
 {
@@ -91,6 +92,75 @@ std::string getMinRotation(std::string str)
     return minStr;
 }
 
+KmerRotationTable::KmerRotationTable(const unsigned kmerLength)
+    : kmerLength_(kmerLength)
+{
+    if ((kmerLength_ == 0) or (kmerLength_ > 15))
+    {
+        throw std::logic_error("Unsupported kmer length for rotation table: " + std::to_string(kmerLength_));
+    }
+
+    const unsigned numKmerCodes(1u << (2 * kmerLength_));
+    const unsigned highBaseShift(2 * (kmerLength_ - 1));
+    minRotationCodes_.resize(numKmerCodes);
+    for (unsigned kmerCode(0); kmerCode < numKmerCodes; ++kmerCode)
+    {
+        // Rotate the kmer left by one base at a time by moving its first (highest) base to the end
+        unsigned minRotationCode(kmerCode);
+        unsigned rotationCode(kmerCode);
+        for (unsigned rotIndex(1); rotIndex < kmerLength_; ++rotIndex)
+        {
+            const unsigned firstBase(rotationCode >> highBaseShift);
+            rotationCode = ((rotationCode << 2) & (numKmerCodes - 1)) | firstBase;
+            minRotationCode = std::min(minRotationCode, rotationCode);
+        }
+        minRotationCodes_[kmerCode] = minRotationCode;
+    }
+}
+
+boost::optional<unsigned> KmerRotationTable::encode(const std::string& sequence, const std::size_t start) const
+{
+    unsigned kmerCode(0);
+    for (std::size_t index(start); index < start + kmerLength_; ++index)
+    {
+        unsigned baseCode(0);
+        switch (sequence[index])
+        {
+        case 'A':
+        case 'a':
+            baseCode = 0;
+            break;
+        case 'C':
+        case 'c':
+            baseCode = 1;
+            break;
+        case 'G':
+        case 'g':
+            baseCode = 2;
+            break;
+        case 'T':
+        case 't':
+            baseCode = 3;
+            break;
+        default:
+            return boost::none;
+        }
+        kmerCode = (kmerCode << 2) | baseCode;
+    }
+    return kmerCode;
+}
+
+std::string KmerRotationTable::decode(unsigned kmerCode) const
+{
+    std::string kmer(kmerLength_, 'A');
+    for (unsigned index(kmerLength_); index > 0; --index)
+    {
+        kmer[index - 1] = "ACGT"[kmerCode & 3];
+        kmerCode >>= 2;
+    }
+    return kmer;
+}
+
 boost::optional<std::pair<unsigned, unsigned>>
 findUsableReadBaseRange(std::vector<uint8_t> binaryQuals, const bool isReversed)
 {
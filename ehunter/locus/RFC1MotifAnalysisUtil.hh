@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <numeric>
 #include <string>
 #include <vector>
@@ -57,6 +58,35 @@ template <typename T> double mean(T begin, T end)
 ///
 std::string getMinRotation(std::string str);
 
+/// \brief Lookup table of the lexicographical minimum rotation of every kmer made of bases A, C, G and T
+///
+/// Kmers are encoded with 2 bits per base in the order A < C < G < T, so that the numeric order of kmer codes matches
+/// the lexicographical order of the kmers.
+///
+class KmerRotationTable
+{
+public:
+    /// \param[in] kmerLength Length of the kmers, limited to 15 so that all codes fit in 30 bits
+    explicit KmerRotationTable(unsigned kmerLength);
+
+    unsigned kmerLength() const { return kmerLength_; }
+    unsigned numKmerCodes() const { return minRotationCodes_.size(); }
+
+    /// Encode the kmer starting at \p start in \p sequence, returns none if the kmer has bases other than ACGT (in
+    /// either case)
+    boost::optional<unsigned> encode(const std::string& sequence, std::size_t start) const;
+
+    /// Decode the kmer code to an uppercase kmer
+    std::string decode(unsigned kmerCode) const;
+
+    /// Get the code of the minimum rotation of the kmer with the given code
+    unsigned getMinRotationCode(unsigned kmerCode) const { return minRotationCodes_[kmerCode]; }
+
+private:
+    unsigned kmerLength_;
+    std::vector<unsigned> minRotationCodes_;
+};
+
 /// \breif Determine the range of bases in a read which are usable for repeat motif extraction.
 ///
 /// This routine will trim off the 3' end of the read at a defined distance before the first low-quality base in the
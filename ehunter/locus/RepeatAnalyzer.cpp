@@ -51,15 +51,15 @@ using std::unique_ptr;
 using std::vector;
 
 void RepeatAnalyzer::processMates(
-    const Read& /*read*/, const GraphAlignment& readAlignment, const Read& /*mate*/,
-    const GraphAlignment& mateAlignment)
+    const Read& /*read*/, const AlignmentScoreSummary& readAlignment, const Read& /*mate*/,
+    const AlignmentScoreSummary& mateAlignment)
 {
     alignMatrix_.add(readAlignment, mateAlignment);
-    alignmentStatsCalculator_.inspect(readAlignment);
-    alignmentStatsCalculator_.inspect(mateAlignment);
+    alignmentStatsCalculator_.inspect(readAlignment.alignment());
+    alignmentStatsCalculator_.inspect(mateAlignment.alignment());
 }
 
-unique_ptr<VariantFindings> RepeatAnalyzer::analyze(const LocusStats& stats)
+unique_ptr<VariantFindings> RepeatAnalyzer::analyze(const LocusStats& stats, int threadCount)
 {
     if (isLowDepth(stats))
     {
@@ -86,16 +86,15 @@ unique_ptr<VariantFindings> RepeatAnalyzer::analyze(const LocusStats& stats)
         strgt::addIrrPairsIfPossibleExpansion(maxMotifsInRead, alignMatrix_, countOfInrepeatReadPairs_);
     }
 
-    auto countsOfSpanningReads = countAligns(StrAlign::Type::kSpanning, alignMatrix_);
-    auto countsOfFlankingReads = countAligns(StrAlign::Type::kFlanking, alignMatrix_);
-    auto countsOfInrepeatReads = countAligns(StrAlign::Type::kInRepeat, alignMatrix_);
+    auto alignCounts = countAligns(alignMatrix_);
 
     auto genotype = strgt::genotype(
-        stats.alleleCount(), repeatUnit_.length(), stats.meanReadLength(), stats.medianFragLength(), alignMatrix_);
+        stats.alleleCount(), repeatUnit_.length(), stats.meanReadLength(), stats.medianFragLength(), alignMatrix_,
+        threadCount);
 
     return make_unique<RepeatFindings>(
-        countsOfSpanningReads, countsOfFlankingReads, countsOfInrepeatReads, stats.alleleCount(), genotype,
-        genotypeFilter);
+        std::move(alignCounts.spanning), std::move(alignCounts.flanking), std::move(alignCounts.inrepeat),
+        stats.alleleCount(), genotype, genotypeFilter);
 }
 
 }
@@ -60,10 +60,10 @@ public:
     void addInrepeatReadPair() { countOfInrepeatReadPairs_++; }
 
     void processMates(
-        const Read& read, const graphtools::GraphAlignment& readAlignment, const Read& mate,
-        const graphtools::GraphAlignment& mateAlignment) override;
+        const Read& read, const AlignmentScoreSummary& readAlignment, const Read& mate,
+        const AlignmentScoreSummary& mateAlignment) override;
 
-    std::unique_ptr<VariantFindings> analyze(const LocusStats& stats) override;
+    std::unique_ptr<VariantFindings> analyze(const LocusStats& stats, int threadCount) override;
 
 private:
     graphtools::NodeId repeatNodeId() const { return nodeIds_.front(); }
@@ -36,14 +36,14 @@ namespace ehunter
 {
 
 void SmallVariantAnalyzer::processMates(
-    const Read& /*read*/, const graphtools::GraphAlignment& readAlignment, const Read& /*mate*/,
-    const graphtools::GraphAlignment& mateAlignment)
+    const Read& /*read*/, const AlignmentScoreSummary& readAlignment, const Read& /*mate*/,
+    const AlignmentScoreSummary& mateAlignment)
 {
-    alignmentStatsCalculator_.inspect(readAlignment);
-    alignmentStatsCalculator_.inspect(mateAlignment);
+    alignmentStatsCalculator_.inspect(readAlignment.alignment());
+    alignmentStatsCalculator_.inspect(mateAlignment.alignment());
 
-    alignmentClassifier_.classify(readAlignment);
-    alignmentClassifier_.classify(mateAlignment);
+    alignmentClassifier_.classify(readAlignment.alignment());
+    alignmentClassifier_.classify(mateAlignment.alignment());
 }
 
 int SmallVariantAnalyzer::countReadsSupportingNode(graphtools::NodeId nodeId) const
@@ -64,7 +64,7 @@ int SmallVariantAnalyzer::countReadsSupportingNode(graphtools::NodeId nodeId) co
     return (numReadsSupportingUpstreamFlank + numReadsSupportingDownstreamFlank) / 2;
 }
 
-std::unique_ptr<VariantFindings> SmallVariantAnalyzer::analyze(const LocusStats& stats)
+std::unique_ptr<VariantFindings> SmallVariantAnalyzer::analyze(const LocusStats& stats, int /*threadCount*/)
 {
     if (isLowDepth(stats))
     {
@@ -55,11 +55,11 @@ public:
 
     ~SmallVariantAnalyzer() = default;
 
-    std::unique_ptr<VariantFindings> analyze(const LocusStats& stats) override;
+    std::unique_ptr<VariantFindings> analyze(const LocusStats& stats, int threadCount) override;
 
     void processMates(
-        const Read& read, const graphtools::GraphAlignment& readAlignment, const Read& mate,
-        const graphtools::GraphAlignment& mateAlignment) override;
+        const Read& read, const AlignmentScoreSummary& readAlignment, const Read& mate,
+        const AlignmentScoreSummary& mateAlignment) override;
 
 protected:
     int countReadsSupportingNode(graphtools::NodeId nodeId) const;
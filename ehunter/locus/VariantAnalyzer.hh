@@ -28,6 +28,7 @@
 #include "graphalign/GraphAlignment.hh"
 #include "graphcore/Graph.hh"
 
+#include "alignment/AlignmentScoreSummary.hh"
 #include "core/Common.hh"
 #include "core/LocusStats.hh"
 #include "core/Parameters.hh"
@@ -51,13 +52,15 @@ public:
     }
     virtual ~VariantAnalyzer() = default;
 
+    /// Alignments of both mates are summarized once per read pair and shared by all variants of the locus
     virtual void processMates(
-        const Read& read, const graphtools::GraphAlignment& readAlignment, const Read& mate,
-        const graphtools::GraphAlignment& mateAlignment)
+        const Read& read, const AlignmentScoreSummary& readAlignment, const Read& mate,
+        const AlignmentScoreSummary& mateAlignment)
         = 0;
 
     bool isLowDepth(const LocusStats& stats) const;
-    virtual std::unique_ptr<VariantFindings> analyze(const LocusStats& stats) = 0;
+    /// Variants supported by very many fragments may be genotyped on up to threadCount threads
+    virtual std::unique_ptr<VariantFindings> analyze(const LocusStats& stats, int threadCount) = 0;
 
     const std::string& variantId() const { return variantId_; }
     const graphtools::Graph& graph() const { return graph_; }
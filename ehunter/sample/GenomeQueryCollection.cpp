@@ -21,6 +21,8 @@
 
 #include "sample/GenomeQueryCollection.hh"
 
+#include <algorithm>
+
 using ehunter::locus::LocusAnalyzer;
 using std::unique_ptr;
 using std::vector;
@@ -47,12 +49,30 @@ void initializeGenomeMask(GenomeMask& genomeMask, vector<unique_ptr<locus::Locus
         }
     }
 }
+
+void initializeOntargetRegionMask(GenomeMask& genomeMask, vector<unique_ptr<locus::LocusAnalyzer>>& locusAnalyzers)
+{
+    // Reads are screened by start position, so regions are extended to cover reads starting just before them
+    const int64_t kMaxReadLength = 1000;
+
+    for (auto& locusAnalyzer : locusAnalyzers)
+    {
+        const LocusSpecification& locusSpec = locusAnalyzer->locusSpec();
+
+        for (const auto& region : locusSpec.targetReadExtractionRegions())
+        {
+            const int64_t start = std::max<int64_t>(0, region.start() - kMaxReadLength);
+            genomeMask.addRegion(region.contigIndex(), start, region.end());
+        }
+    }
+}
 }
 
 GenomeQueryCollection::GenomeQueryCollection(vector<unique_ptr<LocusAnalyzer>>& locusAnalyzers)
     : analyzerFinder(locusAnalyzers)
 {
     initializeGenomeMask(targetRegionMask, locusAnalyzers);
+    initializeOntargetRegionMask(ontargetRegionMask, locusAnalyzers);
 }
 
 }
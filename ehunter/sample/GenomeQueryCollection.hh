@@ -34,6 +34,7 @@ struct GenomeQueryCollection
 
     AnalyzerFinder analyzerFinder; // Analyzers searchable by targeted region
     GenomeMask targetRegionMask; // Marks targeted regions to enable fast read screening
+    GenomeMask ontargetRegionMask; // Marks target (but not offtarget) read extraction regions
 };
 
 }
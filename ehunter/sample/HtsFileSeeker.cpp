@@ -152,12 +152,27 @@ bool HtsFileSeeker::trySeekingToNextPrimaryAlignment()
     return false;
 }
 
+int32_t HtsFileSeeker::currentReadChromIndex() const { return htsAlignmentPtr_->core.tid; }
+
+int32_t HtsFileSeeker::currentReadPosition() const { return htsAlignmentPtr_->core.pos; }
+
+int32_t HtsFileSeeker::currentMateChromIndex() const { return htsAlignmentPtr_->core.mtid; }
+
+int32_t HtsFileSeeker::currentMatePosition() const { return htsAlignmentPtr_->core.mpos; }
+
+string HtsFileSeeker::currentFragmentId() const { return bam_get_qname(htsAlignmentPtr_); }
+
 Read HtsFileSeeker::decodeRead(LinearAlignmentStats& alignmentStats) const
 {
     alignmentStats = decodeAlignmentStats(htsAlignmentPtr_);
     return htshelpers::decodeRead(htsAlignmentPtr_);
 }
 
+void HtsFileSeeker::decodeBasesAsLowQuality(string& bases) const
+{
+    htshelpers::decodeBasesAsLowQuality(htsAlignmentPtr_, bases);
+}
+
 }
 
 }
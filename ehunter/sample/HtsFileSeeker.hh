@@ -55,8 +55,10 @@ public:
     int32_t currentMateChromIndex() const;
     const std::string& currentMateChrom() const;
     int32_t currentMatePosition() const;
+    std::string currentFragmentId() const;
 
     Read decodeRead(LinearAlignmentStats& alignmentStats) const;
+    void decodeBasesAsLowQuality(std::string& bases) const;
 
 private:
     enum class Status
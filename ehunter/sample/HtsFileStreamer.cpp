@@ -108,6 +108,11 @@ bool HtsFileStreamer::isStreamingAlignedReads() const
 
 Read HtsFileStreamer::decodeRead() const { return htshelpers::decodeRead(htsAlignmentPtr_); }
 
+void HtsFileStreamer::decodeBasesAsLowQuality(string& bases) const
+{
+    htshelpers::decodeBasesAsLowQuality(htsAlignmentPtr_, bases);
+}
+
 HtsFileStreamer::~HtsFileStreamer()
 {
     bam_destroy1(htsAlignmentPtr_);
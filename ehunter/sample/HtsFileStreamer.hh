@@ -71,6 +71,7 @@ public:
     bool isStreamingAlignedReads() const;
 
     Read decodeRead() const;
+    void decodeBasesAsLowQuality(std::string& bases) const;
 
 private:
     enum class Status
@@ -28,6 +28,7 @@
 #include <stdexcept>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/functional/hash.hpp>
@@ -40,11 +41,13 @@
 #include "spdlog/fmt/ostr.h"
 // clang-format on
 
+#include "core/LengthStats.hh"
 #include "core/ReadPairs.hh"
 #include "locus/LocusAnalyzer.hh"
 #include "sample/AnalyzerFinder.hh"
 #include "sample/HtsFileSeeker.hh"
 #include "sample/IndexBasedDepthEstimate.hh"
+#include "sample/IrrReadPrefilter.hh"
 #include "sample/MateExtractor.hh"
 
 using boost::make_unique;
@@ -56,6 +59,7 @@ using std::ostream;
 using std::string;
 using std::unique_ptr;
 using std::unordered_map;
+using std::unordered_set;
 using std::vector;
 
 namespace ehunter
@@ -84,8 +88,10 @@ bool checkIfMatesWereMappedNearby(const LinearAlignmentStats& alignmentStats)
     return false;
 }
 
+/// \param[in] droppedFragmentIds Fragments whose mates were deliberately left uncollected and are not recovered
 void recoverMates(
-    htshelpers::MateExtractor& mateExtractor, AlignmentStatsCatalog& alignmentStatsCatalog, ReadPairs& readPairs)
+    htshelpers::MateExtractor& mateExtractor, const unordered_set<string>& droppedFragmentIds,
+    AlignmentStatsCatalog& alignmentStatsCatalog, ReadPairs& readPairs)
 {
     for (auto& fragmentIdAndReadPair : readPairs)
     {
@@ -98,6 +104,11 @@ void recoverMates(
 
         const Read& read = readPair.firstMate ? *readPair.firstMate : *readPair.secondMate;
 
+        if (droppedFragmentIds.count(read.fragmentId()) != 0)
+        {
+            continue;
+        }
+
         const auto alignmentStatsIterator = alignmentStatsCatalog.find(read.readId());
         if (alignmentStatsIterator == alignmentStatsCatalog.end())
         {
@@ -123,13 +134,30 @@ void recoverMates(
     }
 }
 
+/// Checks if a read starting at the given position could overlap any of the regions
+bool isNearRegion(const vector<GenomicRegion>& regions, int32_t contigIndex, int64_t position)
+{
+    const int64_t kMaxReadLength = 1000;
+    for (const auto& region : regions)
+    {
+        if (region.contigIndex() == contigIndex && region.start() - kMaxReadLength <= position
+            && position <= region.end())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 ReadPairs collectCandidateReads(
     const vector<GenomicRegion>& targetRegions, const vector<GenomicRegion>& offtargetRegions,
-    AlignmentStatsCatalog& alignmentStatsCatalog, HtsFileSeeker& htsFileSeeker,
-    htshelpers::MateExtractor& mateExtractor)
+    const IrrReadPrefilter& irrReadPrefilter, AlignmentStatsCatalog& alignmentStatsCatalog,
+    HtsFileSeeker& htsFileSeeker, htshelpers::MateExtractor& mateExtractor)
 {
     vector<GenomicRegion> regionsWithReads = combineRegions(targetRegions, offtargetRegions);
     ReadPairs readPairs;
+    unordered_set<string> droppedFragmentIds;
+    string lowercaseBases;
 
     for (const auto& regionWithReads : regionsWithReads)
     {
@@ -137,6 +165,22 @@ ReadPairs collectCandidateReads(
         htsFileSeeker.setRegion(regionWithReads);
         while (htsFileSeeker.trySeekingToNextPrimaryAlignment())
         {
+            // Pairs with both mates away from target regions are only checked for being IRR pairs, so reads that
+            // cannot be in-repeat are dropped without being decoded
+            const bool isReadNearTargetRegion = isNearRegion(
+                targetRegions, htsFileSeeker.currentReadChromIndex(), htsFileSeeker.currentReadPosition());
+            const bool isMateNearTargetRegion = isNearRegion(
+                targetRegions, htsFileSeeker.currentMateChromIndex(), htsFileSeeker.currentMatePosition());
+            if (!isReadNearTargetRegion && !isMateNearTargetRegion)
+            {
+                htsFileSeeker.decodeBasesAsLowQuality(lowercaseBases);
+                if (!irrReadPrefilter.check(lowercaseBases))
+                {
+                    droppedFragmentIds.insert(htsFileSeeker.currentFragmentId());
+                    continue;
+                }
+            }
+
             LinearAlignmentStats alignmentStats;
             Read read = htsFileSeeker.decodeRead(alignmentStats);
             if (alignmentStats.isPaired)
@@ -154,7 +198,7 @@ ReadPairs collectCandidateReads(
     }
 
     const int numReadsBeforeRecovery = readPairs.NumReads();
-    recoverMates(mateExtractor, alignmentStatsCatalog, readPairs);
+    recoverMates(mateExtractor, droppedFragmentIds, alignmentStatsCatalog, readPairs);
     const int numReadsAfterRecovery = readPairs.NumReads() - numReadsBeforeRecovery;
     spdlog::debug("Recovered {} reads", numReadsAfterRecovery);
 
@@ -260,6 +304,7 @@ public:
 struct LocusThreadLocalData
 {
     std::exception_ptr threadExceptionPtr = nullptr;
+    LengthStats fragLengthStats;
 };
 
 /// \brief Process a series of loci on one thread
@@ -272,6 +317,7 @@ void processLocus(
 {
     LocusThreadLocalData& locusThreadData(locusThreadLocalDataPool[threadIndex]);
     std::string locusId = "Unknown";
+    const int threadCount(locusThreadLocalDataPool.size());
 
     try
     {
@@ -300,15 +346,17 @@ void processLocus(
             auto analyzer(make_unique<LocusAnalyzer>(locusSpec, heuristicParams, alignmentWriter));
             locusAnalyzers.emplace_back(std::move(analyzer));
             AnalyzerFinder analyzerFinder(locusAnalyzers);
+            const IrrReadPrefilter irrReadPrefilter(locusAnalyzers);
 
             AlignmentStatsCatalog alignmentStats;
             ReadPairs readPairs = collectCandidateReads(
-                locusSpec.targetReadExtractionRegions(), locusSpec.offtargetReadExtractionRegions(), alignmentStats,
-                htsFileSeeker, mateExtractor);
+                locusSpec.targetReadExtractionRegions(), locusSpec.offtargetReadExtractionRegions(), irrReadPrefilter,
+                alignmentStats, htsFileSeeker, mateExtractor);
 
             processReads(locusAnalyzers, readPairs, alignmentStats, analyzerFinder, alignerSelector);
 
-            sampleFindings[locusIndex] = locusAnalyzers.front()->analyze(sampleSex, boost::none);
+            sampleFindings[locusIndex] = locusAnalyzers.front()->analyze(sampleSex, boost::none, threadCount);
+            locusThreadData.fragLengthStats.merge(locusAnalyzers.front()->fragLengthStats());
         }
     }
     catch (const std::exception& e)
@@ -380,6 +428,13 @@ SampleFindings htsSeekingSampleAnalysis(
         locusThreads[threadIndex].join();
     }
 
+    LengthStats fragLengthStats;
+    for (const auto& locusThreadData : locusThreadLocalDataPool)
+    {
+        fragLengthStats.merge(locusThreadData.fragLengthStats);
+    }
+    spdlog::debug("Fragment lengths over all loci: {}", fragLengthStats);
+
     return sampleFindings;
 }
 
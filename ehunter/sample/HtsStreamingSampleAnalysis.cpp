@@ -28,13 +28,18 @@
 #include "spdlog/spdlog.h"
 #include <boost/optional.hpp>
 
+// Note that spdlog.h must be included before ostr.h
+#include "spdlog/fmt/ostr.h"
+
 #include "core/HtsHelpers.hh"
+#include "core/LengthStats.hh"
 #include "core/ThreadPool.hh"
 #include "locus/LocusAnalyzer.hh"
 #include "locus/LocusAnalyzerUtil.hh"
 #include "sample/GenomeQueryCollection.hh"
 #include "sample/HtsFileStreamer.hh"
 #include "sample/HtsStreamingReadPairQueue.hh"
+#include "sample/IrrReadPrefilter.hh"
 
 using ehunter::locus::initializeLocusAnalyzers;
 using ehunter::locus::LocusAnalyzer;
@@ -154,6 +159,7 @@ public:
 struct SampleFindingsThreadLocalData
 {
     std::exception_ptr threadExceptionPtr = nullptr;
+    LengthStats fragLengthStats;
 };
 
 /// \brief Analyze a series of loci on one thread
@@ -165,6 +171,7 @@ void analyzeLocus(
 {
     SampleFindingsThreadLocalData& sampleFindingsThreadData(sampleFindingsThreadLocalData[threadIndex]);
     std::string locusId = "Unknown";
+    const int threadCount(sampleFindingsThreadLocalData.size());
 
     try
     {
@@ -184,7 +191,8 @@ void analyzeLocus(
 
             auto& locusAnalyzer(*locusAnalyzers[locusIndex]);
             locusId = locusAnalyzer.locusId();
-            sampleFindings[locusIndex] = locusAnalyzer.analyze(sampleSex, boost::none);
+            sampleFindings[locusIndex] = locusAnalyzer.analyze(sampleSex, boost::none, threadCount);
+            sampleFindingsThreadData.fragLengthStats.merge(locusAnalyzer.fragLengthStats());
         }
     }
     catch (const std::exception& e)
@@ -229,6 +237,7 @@ SampleFindings htsStreamingSampleAnalysis(
     locusAnalyzerThreadSharedData.locusAnalyzers
         = initializeLocusAnalyzers(regionCatalog, heuristicParams, bamletWriter, threadCount);
     GenomeQueryCollection genomeQuery(locusAnalyzerThreadSharedData.locusAnalyzers);
+    const IrrReadPrefilter irrReadPrefilter(locusAnalyzerThreadSharedData.locusAnalyzers);
 
     spdlog::info("Streaming reads");
 
@@ -236,6 +245,7 @@ SampleFindings htsStreamingSampleAnalysis(
     auto ReadEq = [](const Read& read1, const Read& read2) { return (read1.fragmentId() == read2.fragmentId()); };
     using ReadCatalog = absl::flat_hash_set<Read, decltype(ReadHash), decltype(ReadEq)>;
     ReadCatalog unpairedReads(1000, ReadHash, ReadEq);
+    string lowercaseBases;
 
     const unsigned htsDecompressionThreads(std::min(threadCount, 12));
     htshelpers::HtsFileStreamer readStreamer(inputPaths.htsFile(), inputPaths.reference(), htsDecompressionThreads);
@@ -261,6 +271,21 @@ SampleFindings htsStreamingSampleAnalysis(
             continue;
         }
 
+        // Pairs with both mates outside of target regions are only checked for being IRR pairs, so reads that cannot
+        // be in-repeat are dropped here without being decoded. Their mates are then left unpaired.
+        const bool isReadNearOntargetRegion = genomeQuery.ontargetRegionMask.query(
+            readStreamer.currentReadContigId(), readStreamer.currentReadPosition());
+        const bool isMateNearOntargetRegion = genomeQuery.ontargetRegionMask.query(
+            readStreamer.currentMateContigId(), readStreamer.currentMatePosition());
+        if (!isReadNearOntargetRegion && !isMateNearOntargetRegion)
+        {
+            readStreamer.decodeBasesAsLowQuality(lowercaseBases);
+            if (!irrReadPrefilter.check(lowercaseBases))
+            {
+                continue;
+            }
+        }
+
         Read read = readStreamer.decodeRead();
         const auto mateIterator = unpairedReads.find(read);
         if (mateIterator == unpairedReads.end())
@@ -354,6 +379,13 @@ SampleFindings htsStreamingSampleAnalysis(
         sampleFindingsThreads[threadIndex].join();
     }
 
+    LengthStats fragLengthStats;
+    for (const auto& sampleFindingsThreadData : sampleFindingsThreadLocalDataPool)
+    {
+        fragLengthStats.merge(sampleFindingsThreadData.fragLengthStats);
+    }
+    spdlog::debug("Fragment lengths over all loci: {}", fragLengthStats);
+
     return sampleFindings;
 }
 
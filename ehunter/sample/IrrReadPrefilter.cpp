@@ -0,0 +1,104 @@
+//
+// Expansion Hunter
+// Copyright 2016-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/IrrReadPrefilter.hh"
+
+#include <algorithm>
+#include <set>
+
+#include "graphutils/SequenceOperations.hh"
+
+using ehunter::locus::LocusAnalyzer;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace ehunter
+{
+
+namespace
+{
+/// Lexicographically smallest rotation of the motif or of its reverse complement
+string getCanonicalMotif(const string& motif)
+{
+    string canonicalMotif = motif;
+    for (const string& strand : { motif, graphtools::reverseComplement(motif) })
+    {
+        for (size_t offset = 0; offset != strand.length(); ++offset)
+        {
+            const string rotation = strand.substr(offset) + strand.substr(0, offset);
+            canonicalMotif = std::min(canonicalMotif, rotation);
+        }
+    }
+    return canonicalMotif;
+}
+}
+
+IrrReadPrefilter::IrrReadPrefilter(const vector<string>& motifs, double purityCutoff)
+    : purityCutoff_(purityCutoff)
+{
+    initialize(motifs);
+}
+
+IrrReadPrefilter::IrrReadPrefilter(const vector<unique_ptr<LocusAnalyzer>>& locusAnalyzers)
+    : purityCutoff_(1.0)
+{
+    vector<string> motifs;
+    for (const auto& locusAnalyzer : locusAnalyzers)
+    {
+        if (locusAnalyzer->irrPairFinder())
+        {
+            motifs.push_back(locusAnalyzer->irrPairFinder()->targetMotif());
+            purityCutoff_ = std::min(purityCutoff_, locusAnalyzer->irrPairFinder()->purityCutoff());
+        }
+    }
+    initialize(motifs);
+}
+
+void IrrReadPrefilter::initialize(const vector<string>& motifs)
+{
+    std::set<string> canonicalMotifs;
+    for (const auto& motif : motifs)
+    {
+        canonicalMotifs.insert(getCanonicalMotif(motif));
+    }
+
+    for (const auto& motif : canonicalMotifs)
+    {
+        purityCalculators_.emplace_back(motif);
+    }
+}
+
+bool IrrReadPrefilter::check(const string& lowercaseBases) const
+{
+    // Lowercase bases never score below their uppercase versions, so the purity of lowercase bases bounds the purity
+    // of the read from above for any assignment of base qualities
+    for (const auto& purityCalculator : purityCalculators_)
+    {
+        if (purityCalculator.score(lowercaseBases) >= purityCutoff_)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,56 @@
+//
+// Expansion Hunter
+// Copyright 2016-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/WeightedPurityCalculator.hh"
+#include "locus/LocusAnalyzer.hh"
+
+namespace ehunter
+{
+
+/// Screens reads that may be in-repeat reads (IRRs) of a rare motif
+///
+/// Read pairs outside of all target regions are only used to count IRR pairs, and a pair is counted only if both mates
+/// pass the purity check of IrrPairFinder. A read rejected here fails that check for every rare motif of the catalog,
+/// no matter how its base qualities turn out, so it can be dropped before being fully decoded.
+class IrrReadPrefilter
+{
+public:
+    IrrReadPrefilter(const std::vector<std::string>& motifs, double purityCutoff);
+    explicit IrrReadPrefilter(const std::vector<std::unique_ptr<locus::LocusAnalyzer>>& locusAnalyzers);
+
+    /// \param[in] lowercaseBases Read bases all converted to lowercase as if they were of low quality
+    bool check(const std::string& lowercaseBases) const;
+
+private:
+    void initialize(const std::vector<std::string>& motifs);
+
+    // One calculator per distinct motif up to rotations and reverse complementation
+    std::vector<WeightedPurityCalculator> purityCalculators_;
+    double purityCutoff_;
+};
+
+}
@@ -20,6 +20,7 @@
 //
 
 #include "genotyping/AlignMatrix.hh"
+#include "genotyping/AlignMatrixFiltering.hh"
 
 #include "gmock/gmock.h"
 
@@ -136,3 +137,82 @@ TEST(AddingIrrPairs, OtherIrrsPresent_IrrPairsAdded)
     addIrrPairsIfPossibleExpansion(maxMotifsInRead, alignMatrix, numIrrPairs);
     ASSERT_EQ(alignMatrix.numReads(), 6);
 }
+
+TEST(AddingIrrPairs, OtherIrrsPresent_AddedReadsShareAlignments)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+    int strNodeId = 1;
+    AlignMatrix alignMatrix(strNodeId);
+
+    GraphAlignment mate = decodeGraphAlignment(0, "0[5M]", &graph);
+    alignMatrix.add(decodeGraphAlignment(0, "1[1M]1[1M]1[1M]1[1M]1[1M]", &graph), mate);
+    addIrrPairsIfPossibleExpansion(6, alignMatrix, 1);
+
+    ASSERT_EQ(alignMatrix.numReads(), 4);
+    for (int alleleSize = 0; alleleSize != 8; ++alleleSize)
+    {
+        EXPECT_EQ(alignMatrix.getAlign(0, alleleSize), alignMatrix.getAlign(2, alleleSize));
+        EXPECT_EQ(alignMatrix.getAlign(0, alleleSize), alignMatrix.getAlign(3, alleleSize));
+    }
+    EXPECT_EQ(alignMatrix.getBestAlign(0), alignMatrix.getBestAlign(3));
+}
+
+TEST(RemovingReads, ReadsRemoved_RemainingReadsKeepTheirAlignments)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+    AlignMatrix alignMatrix(1);
+
+    GraphAlignment mate = decodeGraphAlignment(0, "0[6M]", &graph);
+    alignMatrix.add(decodeGraphAlignment(3, "0[3M]1[1M]1[1M]", &graph), mate);
+    alignMatrix.add(decodeGraphAlignment(0, "1[1M]1[1M]1[1M]2[4M]", &graph), mate);
+
+    alignMatrix.remove(1);
+    alignMatrix.remove(0);
+    ASSERT_EQ(alignMatrix.getAlign(2, 3), StrAlign('F', 3, 35, 0));
+    alignMatrix.compact();
+
+    ASSERT_EQ(alignMatrix.numReads(), 2);
+    EXPECT_EQ(alignMatrix.getAlign(0, 0), StrAlign('F', 0, 20, 0));
+    EXPECT_EQ(alignMatrix.getAlign(0, 4), StrAlign('F', 3, 35, 0));
+    EXPECT_EQ(alignMatrix.getBestAlign(0), StrAlign('F', 3, 35, 0));
+    EXPECT_EQ(alignMatrix.getAlign(1, 0), StrAlign('O', 0, 30, 0));
+}
+
+TEST(GettingAlignsToAllele, TypicalReads_AlignsOfAllReadsCollected)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+    AlignMatrix alignMatrix(1);
+
+    GraphAlignment mate = decodeGraphAlignment(0, "0[6M]", &graph);
+    alignMatrix.add(decodeGraphAlignment(3, "0[3M]1[1M]1[1M]2[4M]", &graph), mate);
+    alignMatrix.add(decodeGraphAlignment(0, "1[1M]1[1M]1[1M]1[1M]", &graph), mate);
+
+    vector<StrAlign> aligns;
+    for (int alleleSize = 0; alleleSize != 6; ++alleleSize)
+    {
+        alignMatrix.getAlignsToAllele(alleleSize, aligns);
+        ASSERT_EQ(aligns.size(), 4u);
+        for (int readIndex = 0; readIndex != 4; ++readIndex)
+        {
+            EXPECT_EQ(aligns[readIndex], alignMatrix.getAlign(readIndex, alleleSize));
+        }
+    }
+}
+
+TEST(CountingAlignments, TypicalAlignMatrix_AllTypesCountedInOnePass)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+
+    AlignMatrix alignMatrix(1);
+    alignMatrix.add(
+        decodeGraphAlignment(3, "0[3M]1[1M]1[1M]2[4M]", &graph), decodeGraphAlignment(3, "0[3M]1[1M]1[1M]", &graph));
+    alignMatrix.add(decodeGraphAlignment(0, "1[1M]1[1M]1[1M]", &graph), decodeGraphAlignment(0, "0[6M]", &graph));
+
+    const AlignCounts counts = countAligns(alignMatrix);
+    EXPECT_EQ(countAligns(StrAlign::Type::kSpanning, alignMatrix), counts.spanning);
+    EXPECT_EQ(countAligns(StrAlign::Type::kFlanking, alignMatrix), counts.flanking);
+    EXPECT_EQ(countAligns(StrAlign::Type::kInRepeat, alignMatrix), counts.inrepeat);
+    EXPECT_EQ(1, counts.spanning.countOf(2));
+    EXPECT_FALSE(counts.flanking.getElementsWithNonzeroCounts().empty());
+    EXPECT_FALSE(counts.inrepeat.getElementsWithNonzeroCounts().empty());
+}
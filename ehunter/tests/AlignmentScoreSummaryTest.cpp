@@ -0,0 +1,89 @@
+//
+// Expansion Hunter
+// Copyright 2016-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#include "alignment/AlignmentScoreSummary.hh"
+
+#include "gtest/gtest.h"
+
+#include "graphalign/GraphAlignmentOperations.hh"
+#include "graphcore/Graph.hh"
+
+#include "alignment/AlignmentFilters.hh"
+#include "alignment/OperationsOnAlignments.hh"
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
+
+using graphtools::decodeGraphAlignment;
+using graphtools::Graph;
+using graphtools::GraphAlignment;
+
+using namespace ehunter;
+
+TEST(SummarizingAlignmentScores, TypicalAlignment_NodeScoresAndIndelsSummarized)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("TAAT(CAG)*CAACAG(CCG)*CCTT"));
+    const GraphAlignment alignment = decodeGraphAlignment(1, "0[2S3M]1[3M]1[1M1X1D]1[3M]2[2M1I4M2S]", &graph);
+
+    const AlignmentScoreSummary summary(alignment);
+
+    ASSERT_EQ(5, summary.numNodes());
+    EXPECT_EQ(15, summary.getNodeScore(0));
+    EXPECT_EQ(-7, summary.getNodeScore(2));
+    EXPECT_EQ(22, summary.getNodeScore(4));
+    EXPECT_EQ(0, summary.getNodeIndelCount(1));
+    EXPECT_EQ(1, summary.getNodeIndelCount(2));
+    EXPECT_EQ(1, summary.getNodeIndelCount(4));
+
+    EXPECT_EQ(scoreAlignmentToNonloopNodes(alignment), summary.nonloopNodeScore());
+    EXPECT_EQ(2, summary.leftSoftclipLength());
+    EXPECT_EQ(2, summary.rightSoftclipLength());
+}
+
+TEST(SummarizingAlignmentScores, TypicalAlignment_NodeOccurrencesSummarized)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("TAAT(CAG)*CAACAG(CCG)*CCTT"));
+    const GraphAlignment alignment = decodeGraphAlignment(1, "0[3M]1[3M]1[3M]1[3M]2[6M]", &graph);
+
+    const AlignmentScoreSummary summary(alignment);
+
+    EXPECT_EQ(1, summary.getFirstIndexOfNode(1));
+    EXPECT_EQ(3, summary.getLastIndexOfNode(1));
+    EXPECT_EQ(3, summary.countOccurrencesOfNode(1));
+
+    EXPECT_EQ(-1, summary.getFirstIndexOfNode(3));
+    EXPECT_EQ(-1, summary.getLastIndexOfNode(3));
+    EXPECT_EQ(0, summary.countOccurrencesOfNode(3));
+    EXPECT_EQ(0, summary.countOccurrencesOfNode(10));
+}
+
+TEST(FilteringAlignments, AlignmentsWithShortFlanks_FlanksRejected)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATCGATCGAT(CAG)*CAACAG"));
+    const GraphAlignment alignment = decodeGraphAlignment(0, "0[10M]1[3M]1[3M]2[6M]", &graph);
+
+    const AlignmentScoreSummary summary(alignment);
+
+    EXPECT_TRUE(checkIfUpstreamAlignmentIsGood(1, summary));
+    EXPECT_FALSE(checkIfDownstreamAlignmentIsGood(1, summary));
+    EXPECT_FALSE(checkIfUpstreamAlignmentIsGood(3, summary));
+    EXPECT_TRUE(checkIfPassesAlignmentFilters(summary));
+}
@@ -48,6 +48,26 @@ TEST(ManipulatingCountTable, TypicalOperations_TableUpdated)
     EXPECT_EQ(3, countTable.countOf(4));
 }
 
+TEST(ManipulatingCountTable, ElementsAddedOutOfOrder_TableSorted)
+{
+    CountTable countTable;
+    for (int32_t element : { 5, 2, 9, 2, 5, 0 })
+    {
+        countTable.incrementCountOf(element);
+    }
+    countTable.setCountOf(7, 4);
+
+    const map<int32_t, int32_t> expectedElementsAndCounts = { { 0, 1 }, { 2, 2 }, { 5, 2 }, { 7, 4 }, { 9, 1 } };
+    EXPECT_EQ(CountTable(expectedElementsAndCounts), countTable);
+
+    vector<int32_t> iteratedElements;
+    for (const auto& elementAndCount : countTable)
+    {
+        iteratedElements.push_back(elementAndCount.first);
+    }
+    EXPECT_EQ(countTable.getElementsWithNonzeroCounts(), iteratedElements);
+}
+
 TEST(ObtainingElementsWithNonzeroCounts, TypicalCountTable_ElementsObtained)
 {
     const map<int32_t, int32_t> elementsAndCounts = { { 1, 2 }, { 3, 5 }, { 7, 15 } };
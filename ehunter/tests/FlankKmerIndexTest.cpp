@@ -0,0 +1,60 @@
+//
+// Expansion Hunter
+// Copyright 2016-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "alignment/FlankKmerIndex.hh"
+
+#include "gtest/gtest.h"
+
+#include "graphcore/Graph.hh"
+
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
+
+using graphtools::Graph;
+
+using namespace ehunter;
+
+TEST(CountingFlankKmerBases, QueryFromFlanks_AllBasesCovered)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(CAG)*GTTCTA"));
+    FlankKmerIndex flankKmerIndex(graph, 4);
+
+    EXPECT_EQ(6, flankKmerIndex.countBasesCoveredByFlankKmers("ATTCGA"));
+    EXPECT_EQ(6, flankKmerIndex.countBasesCoveredByFlankKmers("CGACAGCA"));
+    EXPECT_EQ(6, flankKmerIndex.countBasesCoveredByFlankKmers("gttcta"));
+}
+
+TEST(CountingFlankKmerBases, QueryFromRepeat_NoBasesCovered)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(CAG)*GTTCTA"));
+    FlankKmerIndex flankKmerIndex(graph, 4);
+
+    EXPECT_EQ(0, flankKmerIndex.countBasesCoveredByFlankKmers("AGCAGCAGCAGCAG"));
+}
+
+TEST(CountingFlankKmerBases, QueryWithFlankAndUnrelatedSequence_FlankBasesCovered)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(CAG)*GTTCTA"));
+    FlankKmerIndex flankKmerIndex(graph, 4);
+
+    EXPECT_EQ(5, flankKmerIndex.countBasesCoveredByFlankKmers("TTCGANNNNCCCCCCC"));
+    EXPECT_EQ(0, flankKmerIndex.countBasesCoveredByFlankKmers("AT"));
+}
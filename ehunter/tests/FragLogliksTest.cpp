@@ -78,3 +78,25 @@ TEST(ReadLogliks, TypicalReads_Computed)
     EXPECT_THAT(logliks.getLoglik(3, 2), DoubleNear(-17.26, 0.1));
     EXPECT_THAT(logliks.getLoglik(3, 3), DoubleNear(-16.03, 0.1));
 }
+
+TEST(ReadLogliks, ManyAlleleSizesRequested_EarlierLogliksStayValid)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+
+    AlignMatrix alignMatrix(1);
+    GraphAlignment mate = decodeGraphAlignment(0, "0[6M]", &graph);
+    alignMatrix.add(decodeGraphAlignment(3, "0[3M]1[1M]1[1M]2[4M]", &graph), mate);
+    alignMatrix.add(decodeGraphAlignment(3, "0[3M]1[1M]1[1M]", &graph), mate);
+
+    FragLogliks logliks(1, 8, 20, &alignMatrix);
+    const vector<double>& fragLogliks = logliks.getLogliks(2);
+    ASSERT_EQ(fragLogliks.size(), 2u);
+    for (int alleleSize = 0; alleleSize != 1000; ++alleleSize)
+    {
+        logliks.getLogliks(alleleSize);
+    }
+
+    EXPECT_THAT(fragLogliks[0], DoubleNear(-8.07, 0.1));
+    EXPECT_THAT(fragLogliks[1], DoubleNear(-13.32, 0.1));
+    EXPECT_EQ(&fragLogliks, &logliks.getLogliks(2));
+}
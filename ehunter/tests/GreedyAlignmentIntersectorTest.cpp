@@ -21,17 +21,22 @@
 
 #include "alignment/GreedyAlignmentIntersector.hh"
 
+#include <list>
+
 #include "gtest/gtest.h"
 
 #include "graphalign/GraphAlignmentOperations.hh"
 #include "graphcore/Graph.hh"
 #include "graphcore/Path.hh"
 
+#include "alignment/OperationsOnAlignments.hh"
 #include "io/RegionGraph.hh"
 #include "locus/LocusSpecification.hh"
 
 using graphtools::Graph;
+using graphtools::GraphAlignment;
 using graphtools::Path;
+using std::list;
 
 using namespace ehunter;
 
@@ -109,3 +114,61 @@ TEST(IntersectingPaths, NonintersectingPaths_HandleledProperly)
         EXPECT_FALSE(alignmentIntersector.intersect());
     }
 }
+
+TEST(IntersectingPaths, IntersectionStartsAtMismatch_HandledProperly)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("TAAT(CAG)*CAACAG(CCG)*CCTT"));
+
+    const auto firstAlignment = decodeGraphAlignment(2, "0[2M]1[1X2M]1[3M]", &graph);
+    const auto secondAlignment = decodeGraphAlignment(0, "1[3M]1[3M]", &graph);
+
+    GreedyAlignmentIntersector alignmentIntersector(firstAlignment, secondAlignment);
+
+    EXPECT_FALSE(alignmentIntersector.intersectWindows());
+    EXPECT_FALSE(alignmentIntersector.intersect());
+}
+
+TEST(IntersectingWindows, IntersectionOfWindows_SameAsIntersectionOfAlignments)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("TAAT(CAG)*CAACAG(CCG)*CCTT"));
+
+    const auto firstAlignment = decodeGraphAlignment(1, "0[3M]1[3M]1[3M]1[3M]1[3M]", &graph);
+    const auto secondAlignment = decodeGraphAlignment(2, "0[2M]1[3M]1[3M]1[2M]", &graph);
+
+    GreedyAlignmentIntersector alignmentIntersector(firstAlignment, secondAlignment);
+    const auto windowIntersection = alignmentIntersector.intersectWindows();
+    const auto alignmentIntersection = alignmentIntersector.intersect();
+
+    ASSERT_TRUE(windowIntersection);
+    EXPECT_EQ(4, windowIntersection->numNodes());
+    EXPECT_EQ(*alignmentIntersection, windowIntersection->toAlignment());
+}
+
+TEST(ComputingCanonicalAlignment, ManyTiedAlignments_AlignmentsIntersected)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("TAAT(CAG)*CAACAG(CCG)*CCTT"));
+
+    const auto firstAlignment = decodeGraphAlignment(2, "0[2M]1[3M]1[3M]2[2M]", &graph);
+    const auto secondAlignment = decodeGraphAlignment(1, "1[2M]1[3M]2[1M]", &graph);
+
+    list<GraphAlignment> alignments = { firstAlignment };
+    for (int alignmentIndex = 0; alignmentIndex != 50; ++alignmentIndex)
+    {
+        alignments.push_back(secondAlignment);
+        alignments.push_back(firstAlignment);
+    }
+
+    const auto expectedAlignment = decodeGraphAlignment(1, "1[3S2M]1[3M]2[1M1S]", &graph);
+    EXPECT_EQ(expectedAlignment, computeCanonicalAlignment(alignments));
+}
+
+TEST(ComputingCanonicalAlignment, IntersectionIsNotLocal_FirstAlignmentReturned)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("TAAT(CAG)*CAACAG(CCG)*CCTT"));
+
+    const auto firstAlignment = decodeGraphAlignment(2, "0[2M]1[1X2M]1[3M]", &graph);
+    const auto secondAlignment = decodeGraphAlignment(2, "0[2M]1[3M]1[3M]", &graph);
+    const auto thirdAlignment = decodeGraphAlignment(0, "1[3M]1[3M]", &graph);
+
+    EXPECT_EQ(firstAlignment, computeCanonicalAlignment({ firstAlignment, secondAlignment, thirdAlignment }));
+}
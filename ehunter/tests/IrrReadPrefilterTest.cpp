@@ -0,0 +1,91 @@
+//
+// Expansion Hunter
+// Copyright 2016-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/IrrReadPrefilter.hh"
+
+#include <cctype>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "locus/IrrPairFinder.hh"
+
+using namespace ehunter;
+using std::string;
+
+TEST(IrrReadPrefilterTest, ReadsMadeOfRareMotifs_Passed)
+{
+    IrrReadPrefilter prefilter({ "CGG", "AAAAG" }, 0.9);
+
+    ASSERT_TRUE(prefilter.check("cggcggcggcggcgg"));
+    ASSERT_TRUE(prefilter.check("ccgccgccgccgccg"));
+    ASSERT_TRUE(prefilter.check("aagaaaagaaaagaaaag"));
+    ASSERT_TRUE(prefilter.check("cttttcttttcttttc"));
+}
+
+TEST(IrrReadPrefilterTest, ReadsNotMadeOfRareMotifs_Rejected)
+{
+    IrrReadPrefilter prefilter({ "CGG", "AAAAG" }, 0.9);
+
+    ASSERT_FALSE(prefilter.check("atcgatcgatcgatcg"));
+    ASSERT_FALSE(prefilter.check("cagcagcagcagcag"));
+    ASSERT_FALSE(prefilter.check("nnnnnnnnnnnnnnnn"));
+}
+
+TEST(IrrReadPrefilterTest, NoRareMotifs_AllReadsRejected)
+{
+    IrrReadPrefilter prefilter({}, 0.9);
+    ASSERT_FALSE(prefilter.check("cggcggcggcggcgg"));
+}
+
+TEST(IrrReadPrefilterTest, ReadsOfIrrPairs_NeverRejected)
+{
+    const string motif = "CGG";
+    const string bases = "ACGTN";
+    locus::IrrPairFinder irrPairFinder(motif);
+    IrrReadPrefilter prefilter({ motif }, irrPairFinder.purityCutoff());
+
+    std::mt19937 randomEngine(42);
+    std::uniform_int_distribution<int> errorDistribution(0, 9);
+    std::uniform_int_distribution<int> baseDistribution(0, 4);
+    std::uniform_int_distribution<int> qualityDistribution(0, 1);
+
+    for (int iteration = 0; iteration != 2000; ++iteration)
+    {
+        string read;
+        string lowercaseRead;
+        for (int position = 0; position != 30; ++position)
+        {
+            char base = motif[position % motif.length()];
+            if (errorDistribution(randomEngine) == 0)
+            {
+                base = bases[baseDistribution(randomEngine)];
+            }
+            lowercaseRead += std::tolower(base);
+            read += qualityDistribution(randomEngine) ? std::tolower(base) : base;
+        }
+
+        if (irrPairFinder.check(read, read))
+        {
+            ASSERT_TRUE(prefilter.check(lowercaseRead)) << read;
+        }
+    }
+}
@@ -0,0 +1,80 @@
+//
+// Expansion Hunter
+// Copyright 2016-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#include "core/LengthStats.hh"
+
+#include "gtest/gtest.h"
+
+using namespace ehunter;
+
+TEST(LengthStats, NoLengthsAdded_ZeroSummaries)
+{
+    LengthStats stats;
+    EXPECT_EQ(0, stats.count());
+    EXPECT_DOUBLE_EQ(0.0, stats.mean());
+    EXPECT_EQ(0, stats.median());
+}
+
+TEST(LengthStats, TypicalLengths_QuantilesCalculated)
+{
+    LengthStats stats;
+    for (int length : { 300, 100, 500, 200, 400, 1000 })
+    {
+        stats.add(length);
+    }
+
+    EXPECT_EQ(6, stats.count());
+    EXPECT_EQ(2500, stats.sum());
+    EXPECT_EQ(300, stats.median());
+    EXPECT_EQ(100, stats.quantile(0.0));
+    EXPECT_EQ(200, stats.quantile(0.25));
+    EXPECT_EQ(1000, stats.quantile(1.0));
+}
+
+TEST(LengthStats, LengthsBeyondHistogram_CountedInLastBin)
+{
+    LengthStats stats;
+    stats.add(LengthStats::kMaxBinnedLength + 500);
+
+    EXPECT_EQ(LengthStats::kMaxBinnedLength, stats.median());
+    EXPECT_DOUBLE_EQ(LengthStats::kMaxBinnedLength + 500, stats.mean());
+}
+
+TEST(LengthStats, StatsMerged_SameAsAddingAllLengths)
+{
+    LengthStats firstStats;
+    LengthStats secondStats;
+    LengthStats allStats;
+    for (int length = 100; length != 200; ++length)
+    {
+        (length % 3 == 0 ? firstStats : secondStats).add(length);
+        allStats.add(length);
+    }
+
+    firstStats.merge(secondStats);
+    EXPECT_EQ(allStats.count(), firstStats.count());
+    EXPECT_EQ(allStats.sum(), firstStats.sum());
+    for (double fraction : { 0.1, 0.5, 0.9 })
+    {
+        EXPECT_EQ(allStats.quantile(fraction), firstStats.quantile(fraction));
+    }
+}
@@ -64,3 +64,20 @@ TEST(LocusStatsCalculator, TypicalReadLengths_StatsCalculated)
 
     ASSERT_EQ(LocusStats(AlleleCount::kTwo, 3, 0, 18), statsCalculator.estimate(Sex::kFemale));
 }
+
+TEST(LocusStatsCalculator, TypicalFragLengths_MedianFragLengthCalculated)
+{
+    graphtools::Graph graph = graphtools::makeStrGraph("TAATGCCTTA", "CCG", "CCTTATTA");
+
+    LocusStatsCalculator statsCalculator(ChromType::kAutosome, graph);
+
+    GraphAlignment readAlignment = decodeGraphAlignment(0, "0[3M]", &graph);
+    for (int mateStart : { 1, 2, 6 })
+    {
+        GraphAlignment mateAlignment = decodeGraphAlignment(mateStart, "0[3M]", &graph);
+        statsCalculator.inspect(readAlignment, mateAlignment);
+    }
+
+    EXPECT_EQ(3, statsCalculator.fragLengthStats().count());
+    EXPECT_EQ(5, statsCalculator.estimate(Sex::kFemale).medianFragLength());
+}
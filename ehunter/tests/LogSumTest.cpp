@@ -0,0 +1,76 @@
+//
+// ExpansionHunter
+// Copyright (c) 2020 Illumina, Inc.
+//
+// Author: Konrad Scheffler <kscheffler@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#include "core/LogSum.hh"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using std::vector;
+
+TEST(LogSum, PairOfValues_SummedInLogSpace)
+{
+    EXPECT_NEAR(std::log(std::exp(-2.0) + std::exp(-3.5)), getLogSum(-2.0, -3.5), 1e-12);
+    EXPECT_NEAR(std::log(std::exp(-2.0) + std::exp(-3.5)), getLogSum(-3.5, -2.0), 1e-12);
+    EXPECT_DOUBLE_EQ(-1000.0, getLogSum(-1000.0, -5000.0));
+}
+
+TEST(LogSum, ArrayOfValues_SummedInLogSpace)
+{
+    const vector<double> values = { -1.0, -7.5, -2.25, -30.0, -1.0 };
+    double expectedLogSum = values.front();
+    for (std::size_t index = 1; index != values.size(); ++index)
+    {
+        expectedLogSum = getLogSum(expectedLogSum, values[index]);
+    }
+
+    EXPECT_NEAR(expectedLogSum, getLogSum(values.data(), values.size()), 1e-12);
+    EXPECT_EQ(-std::numeric_limits<double>::infinity(), getLogSum(values.data(), 0));
+}
+
+TEST(LogSum, ArraysOfPairs_SameAsSummingPairwiseLogSums)
+{
+    const vector<double> x1 = { -10.0, -2.0, -300.0, -4.5, -4.5 };
+    const vector<double> x2 = { -1.0, -20.0, -3.0, -4.5, -4.6 };
+    const double x2Offset = std::log(1.0 - 0.001);
+
+    double expectedSum = 0;
+    for (std::size_t index = 0; index != x1.size(); ++index)
+    {
+        expectedSum += getLogSum(x1[index], x2Offset + x2[index]);
+    }
+
+    EXPECT_EQ(expectedSum, sumLogSums(x1.data(), x2.data(), x2Offset, x1.size()));
+}
+
+TEST(LogSum, FastApproximation_WithinErrorBoundOfExactValue)
+{
+    double maxError = 0;
+    for (double x2 = -40.0; x2 <= 0.0; x2 += 0.0037)
+    {
+        maxError = std::max(maxError, std::abs(getLogSum(-1.0, x2) - getLogSumFast(-1.0, x2)));
+    }
+
+    EXPECT_LT(maxError, 1e-5);
+    const double kInfinity = std::numeric_limits<double>::infinity();
+    EXPECT_EQ(-kInfinity, getLogSumFast(-kInfinity, -kInfinity));
+}
@@ -0,0 +1,121 @@
+//
+// Expansion Hunter
+// Copyright 2016-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Chris Saunders <csaunders@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "locus/RFC1MotifAnalysis.hh"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "graphalign/GraphAlignmentOperations.hh"
+#include "graphcore/GraphBuilders.hh"
+
+using graphtools::decodeGraphAlignment;
+using graphtools::Graph;
+using graphtools::GraphAlignment;
+using std::string;
+using std::vector;
+using namespace ehunter;
+
+namespace
+{
+const string kLeftFlank = "CTGTGTGTCTATAGCGTGTCAGGTCCTGCC";
+const string kRightFlank = "TTCCATCCTCATCTACACTCATTAGGCCTG";
+
+// Read made of 20 bases of each flank around the given number of repeat units
+string makeRead(const string& motif, int numRepeatUnits)
+{
+    string read = kLeftFlank.substr(10);
+    for (int unitIndex = 0; unitIndex != numRepeatUnits; ++unitIndex)
+    {
+        read += motif;
+    }
+    return read + kRightFlank.substr(0, 20);
+}
+
+GraphAlignment makeAlignment(const Graph& graph, int numRepeatUnits)
+{
+    string cigar = "0[20M]";
+    for (int unitIndex = 0; unitIndex != numRepeatUnits; ++unitIndex)
+    {
+        cigar += "1[5M]";
+    }
+    return decodeGraphAlignment(10, cigar + "2[20M]", &graph);
+}
+}
+
+TEST(RFC1MotifAccumulatorTest, ReadsNotOverlappingRepeat_Ignored)
+{
+    const Graph graph = graphtools::makeStrGraph(kLeftFlank, "AAAAG", kRightFlank);
+    RFC1MotifAccumulator accumulator;
+    accumulator.testAndAddRead(kLeftFlank, false, decodeGraphAlignment(0, "0[30M]", &graph));
+
+    EXPECT_EQ(0u, accumulator.numSpanningReads());
+    EXPECT_TRUE(accumulator.getMotifAndPurityData(0, { "AAGGG" }).motifMap.empty());
+}
+
+TEST(RFC1MotifAccumulatorTest, SpanningReadsWithPathogenicMotif_MotifsCounted)
+{
+    const Graph graph = graphtools::makeStrGraph(kLeftFlank, "AAAAG", kRightFlank);
+    RFC1MotifAccumulator accumulator;
+    for (int readIndex = 0; readIndex != 2; ++readIndex)
+    {
+        accumulator.testAndAddRead(makeRead("GGGAA", 16), readIndex == 1, makeAlignment(graph, 16));
+    }
+
+    EXPECT_EQ(2u, accumulator.numSpanningReads());
+
+    // The first and last repeat units of each read are not used
+    const MotifAndPurityData mpData = accumulator.getMotifAndPurityData(0, { "AAGGG", "ACAGG" });
+    ASSERT_EQ(1u, mpData.motifMap.size());
+    const MotifObservations& observations = mpData.motifMap.at("AAGGG");
+    EXPECT_EQ(28u, observations.count);
+    EXPECT_DOUBLE_EQ(28.0, observations.weightedCount);
+    EXPECT_DOUBLE_EQ(1.0, observations.weightedFrac);
+    EXPECT_EQ(vector<double>({ 1.0, 1.0 }), mpData.pathogenicMotifFractionPerRead);
+}
+
+TEST(RFC1MotifAccumulatorTest, ReadsSpanningFewRepeatUnits_ExcludedByMinRepeatMotifSpan)
+{
+    const Graph graph = graphtools::makeStrGraph(kLeftFlank, "AAAAG", kRightFlank);
+    RFC1MotifAccumulator accumulator;
+    for (int readIndex = 0; readIndex != 2; ++readIndex)
+    {
+        accumulator.testAndAddRead(makeRead("AAAAG", 12), false, makeAlignment(graph, 12));
+    }
+
+    EXPECT_EQ(1u, accumulator.getMotifAndPurityData(12, { "AAGGG" }).motifMap.size());
+    EXPECT_TRUE(accumulator.getMotifAndPurityData(13, { "AAGGG" }).motifMap.empty());
+    EXPECT_TRUE(accumulator.getMotifAndPurityData(13, { "AAGGG" }).pathogenicMotifFractionPerRead.empty());
+}
+
+TEST(RFC1MotifAccumulatorTest, LowQualityReads_NoHighQualityMotifs)
+{
+    const Graph graph = graphtools::makeStrGraph(kLeftFlank, "AAAAG", kRightFlank);
+    RFC1MotifAccumulator accumulator;
+    const string read = makeRead("aaggg", 16);
+    for (int readIndex = 0; readIndex != 2; ++readIndex)
+    {
+        accumulator.testAndAddRead(read, false, makeAlignment(graph, 16));
+    }
+
+    EXPECT_TRUE(accumulator.getMotifAndPurityData(0, { "AAGGG" }).motifMap.empty());
+}
@@ -37,6 +37,26 @@ TEST(RFC1MotifAnalysisTests, MinRotationTest)
     EXPECT_EQ("GGGGT", getMinRotation("GGGGT"));
 }
 
+TEST(RFC1MotifAnalysisTests, KmerRotationTable_MatchesMinRotation)
+{
+    const KmerRotationTable rotationTable(5);
+    ASSERT_EQ(1024u, rotationTable.numKmerCodes());
+    for (unsigned kmerCode(0); kmerCode < rotationTable.numKmerCodes(); ++kmerCode)
+    {
+        const std::string kmer(rotationTable.decode(kmerCode));
+        EXPECT_EQ(kmerCode, *rotationTable.encode(kmer, 0));
+        EXPECT_EQ(getMinRotation(kmer), rotationTable.decode(rotationTable.getMinRotationCode(kmerCode)));
+    }
+}
+
+TEST(RFC1MotifAnalysisTests, KmerRotationTable_EncodeTest)
+{
+    const KmerRotationTable rotationTable(5);
+    EXPECT_EQ(*rotationTable.encode("GGCAA", 0), *rotationTable.encode("TggcaaT", 1));
+    EXPECT_EQ("AAGGC", rotationTable.decode(rotationTable.getMinRotationCode(*rotationTable.encode("GGCAA", 0))));
+    EXPECT_FALSE(rotationTable.encode("GGNAA", 0));
+}
+
 TEST(RFC1MotifAnalysisTests, FindUsableBaseRange_Test)
 {
     // Test fwd orientation
@@ -21,6 +21,8 @@
 
 #include "genotyping/SmallVariantGenotyper.hh"
 
+#include <chrono>
+#include <iostream>
 #include <numeric>
 
 #include "gtest/gtest.h"
@@ -54,3 +56,38 @@ TEST(SmallVariantGenotyper, RegularGenotye)
     SmallVariantGenotype gt2 = *genotyper.genotype(1, 20);
     EXPECT_EQ(alt_genotype, gt2);
 }
+
+TEST(SmallVariantGenotyper, HighReadCounts_GenotypedWithoutUnderflow)
+{
+    SmallVariantGenotyper genotyper(15.0, (AlleleCount)2);
+
+    SmallVariantGenotype alt_genotype(AlleleType::kAlt, AlleleType::kAlt);
+    EXPECT_EQ(alt_genotype, *genotyper.genotype(5, 3000));
+
+    SmallVariantGenotype het_genotype(AlleleType::kRef, AlleleType::kAlt);
+    EXPECT_EQ(het_genotype, *genotyper.genotype(1500, 1500));
+}
+
+// Micro-benchmark of genotyping many small variants; run with --gtest_also_run_disabled_tests
+TEST(DISABLED_SmallVariantGenotyper, ManyReadCounts_Genotyped)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    int numAltGenotypes = 0;
+    for (double haplotypeDepth = 5.0; haplotypeDepth < 50.0; haplotypeDepth += 0.5)
+    {
+        SmallVariantGenotyper genotyper(haplotypeDepth, (AlleleCount)2);
+        for (int refCount = 0; refCount != 100; ++refCount)
+        {
+            for (int altCount = 1; altCount != 100; ++altCount)
+            {
+                numAltGenotypes += genotyper.genotype(refCount, altCount)->isHomAlt();
+            }
+        }
+    }
+
+    const auto elapsedTime = std::chrono::steady_clock::now() - startTime;
+    std::cout << "Genotyped 891000 variants in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(elapsedTime).count() << " ms" << std::endl;
+    EXPECT_GT(numAltGenotypes, 0);
+}
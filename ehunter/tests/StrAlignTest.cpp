@@ -21,16 +21,26 @@
 
 #include "genotyping/StrAlign.hh"
 
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "graphalign/GraphAlignment.hh"
 #include "graphalign/GraphAlignmentOperations.hh"
+#include "graphalign/LinearAlignmentOperations.hh"
 
 #include "io/GraphBlueprint.hh"
 #include "io/RegionGraph.hh"
 
 using graphtools::Graph;
 using graphtools::GraphAlignment;
+using graphtools::Operation;
+using graphtools::OperationType;
+using std::string;
+using std::vector;
 using namespace ehunter;
 
 TEST(GettingCompatibleAlignmentByClippingFromLeft, TypicalRead_CompatibleAlignmentFound)
@@ -139,3 +149,186 @@ TEST(GettingCompatibleAlignment, TypicalRead_CompatibleAlignmentFound)
         EXPECT_EQ(StrAlign(StrAlign::Type::kFlanking, 2, 50, 0), alignmentCalculator.findConsistentAlignment(2, align));
     }
 }
+
+namespace
+{
+
+// Reference implementation that rescores the alignment node by node for the given allele size
+enum class ClipType
+{
+    kFromLeft,
+    kFromRight,
+    kStutter
+};
+
+StrAlign scoreNodeByNode(ClipType clipType, int strNode, int numMotifsInAllele, const GraphAlignment& alignment)
+{
+    const int numMotifsInAlignment = std::count(alignment.path().begin(), alignment.path().end(), strNode);
+    int leftFlankScore = 0, strScore = 0, rightFlankScore = 0, strIndelCount = 0;
+    int motifIndex = 0;
+    for (int nodeIndex = 0; nodeIndex != static_cast<int>(alignment.size()); ++nodeIndex)
+    {
+        const int node = alignment.getNodeIdByIndex(nodeIndex);
+        const int nodeScore = graphtools::scoreAlignment(alignment[nodeIndex], 5, -4, -8);
+        int nodeIndelCount = 0;
+        for (const Operation& operation : alignment[nodeIndex])
+        {
+            if (operation.type() == OperationType::kInsertionToRef
+                || operation.type() == OperationType::kDeletionFromRef)
+            {
+                nodeIndelCount += operation.length();
+            }
+        }
+
+        if (node < strNode)
+        {
+            leftFlankScore += nodeScore;
+        }
+        else if (strNode < node)
+        {
+            rightFlankScore += nodeScore;
+        }
+        else
+        {
+            const bool isMotifKept = clipType == ClipType::kFromLeft
+                ? numMotifsInAlignment - motifIndex <= numMotifsInAllele
+                : motifIndex + 1 <= numMotifsInAllele;
+            if (isMotifKept)
+            {
+                strScore += nodeScore;
+                strIndelCount += nodeIndelCount;
+            }
+            ++motifIndex;
+        }
+    }
+
+    const int left = std::max(leftFlankScore, 0);
+    const int right = std::max(rightFlankScore, 0);
+    const int numCompatibleMotifs = std::min(numMotifsInAlignment, numMotifsInAllele);
+    using Type = StrAlign::Type;
+
+    if (clipType == ClipType::kStutter)
+    {
+        if (left == 0 || right == 0)
+        {
+            return { Type::kOutside, 0, 0, 0 };
+        }
+        const int numDiscrepantMotifs = std::abs(numMotifsInAlignment - numMotifsInAllele);
+        const int discrepantLength = alignment.path().graphRawPtr()->nodeSeq(strNode).length() * numDiscrepantMotifs;
+        const int penaltyScore = numDiscrepantMotifs > 0 ? -24 - 12 * (discrepantLength - 1) : 0;
+        return { Type::kSpanning, numMotifsInAllele, std::max(left + strScore + penaltyScore + right, 0),
+                 strIndelCount };
+    }
+
+    if (numMotifsInAlignment == 0 && (left == 0 || right == 0))
+    {
+        return { Type::kOutside, 0, left + right, 0 };
+    }
+    if (left == 0 && right == 0)
+    {
+        return { Type::kInRepeat, numCompatibleMotifs, strScore, strIndelCount };
+    }
+
+    // Flank on the clipped side and flank on the kept side
+    const int clippedFlankScore = clipType == ClipType::kFromLeft ? left : right;
+    const int keptFlankScore = clipType == ClipType::kFromLeft ? right : left;
+    if (left > 0 && right > 0)
+    {
+        if (numMotifsInAlignment == numMotifsInAllele)
+        {
+            return { Type::kSpanning, numCompatibleMotifs, left + strScore + right, strIndelCount };
+        }
+        return { Type::kFlanking, numCompatibleMotifs, strScore + keptFlankScore, strIndelCount };
+    }
+    if (clippedFlankScore == 0)
+    {
+        return { Type::kFlanking, numCompatibleMotifs, strScore + keptFlankScore, strIndelCount };
+    }
+    if (numMotifsInAlignment <= numMotifsInAllele)
+    {
+        return { Type::kFlanking, numCompatibleMotifs, clippedFlankScore + strScore, strIndelCount };
+    }
+    return { Type::kInRepeat, numCompatibleMotifs, strScore, strIndelCount };
+}
+
+string generateNodeCigar(std::mt19937& generator, int referenceLength)
+{
+    string cigar;
+    char previousType = ' ';
+    while (referenceLength > 0)
+    {
+        const int draw = generator() % 20;
+        const char type = draw < 12 ? 'M' : (draw < 15 ? 'X' : (draw < 17 ? 'D' : 'I'));
+        if (type == previousType || (type == 'I' && (previousType == 'D' || cigar.empty())))
+        {
+            continue;
+        }
+        const int length = type == 'I' ? 1 + generator() % 2 : 1 + generator() % std::min(referenceLength, 3);
+        if (type != 'I')
+        {
+            referenceLength -= length;
+        }
+        cigar += std::to_string(length) + type;
+        previousType = type;
+    }
+    return cigar;
+}
+
+}
+
+TEST(GettingCompatibleAlignment, RandomAlignments_SameResultsAsScoringNodeByNode)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGATTGC(CAG)*ATGTCGGATA"));
+    const int strNode = 1;
+    ConsistentAlignmentCalculator alignmentCalculator(strNode);
+    std::mt19937 generator(42);
+
+    for (int iteration = 0; iteration != 2000; ++iteration)
+    {
+        vector<int> nodes;
+        if (generator() % 2)
+        {
+            nodes.push_back(0);
+        }
+        nodes.insert(nodes.end(), generator() % 7, strNode);
+        if (generator() % 2 || nodes.empty())
+        {
+            nodes.push_back(2);
+        }
+
+        const int firstNodeLength = graph.nodeSeq(nodes.front()).length();
+        const int lastNodeLength = graph.nodeSeq(nodes.back()).length();
+        const int start = generator() % firstNodeLength;
+        const int minEnd = nodes.size() == 1 ? start + 1 : 1;
+        const int end = minEnd + generator() % (lastNodeLength - minEnd + 1);
+
+        string graphCigar;
+        for (int nodeIndex = 0; nodeIndex != static_cast<int>(nodes.size()); ++nodeIndex)
+        {
+            const int nodeStart = nodeIndex == 0 ? start : 0;
+            const int nodeEnd = nodeIndex + 1 == static_cast<int>(nodes.size())
+                ? end
+                : static_cast<int>(graph.nodeSeq(nodes[nodeIndex]).length());
+            graphCigar += std::to_string(nodes[nodeIndex]) + "[" + generateNodeCigar(generator, nodeEnd - nodeStart)
+                + "]";
+        }
+        const GraphAlignment alignment = decodeGraphAlignment(start, graphCigar, &graph);
+
+        const int numMotifsInAlignment = std::count(nodes.begin(), nodes.end(), strNode);
+        for (int numMotifs = 0; numMotifs <= numMotifsInAlignment + 3; ++numMotifs)
+        {
+            ASSERT_EQ(
+                scoreNodeByNode(ClipType::kFromLeft, strNode, numMotifs, alignment),
+                alignmentCalculator.clipFromLeft(numMotifs, alignment))
+                << alignment;
+            ASSERT_EQ(
+                scoreNodeByNode(ClipType::kFromRight, strNode, numMotifs, alignment),
+                alignmentCalculator.clipFromRight(numMotifs, alignment))
+                << alignment;
+            ASSERT_EQ(
+                scoreNodeByNode(ClipType::kStutter, strNode, numMotifs, alignment),
+                alignmentCalculator.removeStutter(numMotifs, alignment))
+                << alignment;
+        }
+    }
+}
@@ -21,14 +21,13 @@
 
 #include "genotyping/StrGenotyper.hh"
 
-#include <unordered_set>
-
 #include "gmock/gmock.h"
 
 #include "graphalign/GraphAlignment.hh"
 #include "graphalign/GraphAlignmentOperations.hh"
 
 #include "genotyping/AlignMatrix.hh"
+#include "genotyping/FragLogliks.hh"
 #include "genotyping/RepeatGenotype.hh"
 #include "io/GraphBlueprint.hh"
 #include "io/RegionGraph.hh"
@@ -38,7 +37,6 @@ using namespace strgt;
 
 using graphtools::Graph;
 using graphtools::GraphAlignment;
-using std::unordered_set;
 using std::vector;
 
 TEST(StrAlleleCandidates, TypicalAlignments_Computed)
@@ -51,11 +49,11 @@ TEST(StrAlleleCandidates, TypicalAlignments_Computed)
     GraphAlignment mate = decodeGraphAlignment(0, "0[6M]", &graph);
     alignMatrix.add(decodeGraphAlignment(3, "0[3M]1[3M]1[3M]2[4M]", &graph), mate);
     alignMatrix.add(decodeGraphAlignment(3, "0[3M]1[3M]1[3M]1[3M]2[2M]", &graph), mate);
-    ASSERT_EQ(getAlleleCandidates(readLen, motifLen, alignMatrix), unordered_set<int>({ 2, 3 }));
+    ASSERT_EQ(getAlleleCandidates(readLen, motifLen, alignMatrix), vector<int>({ 2, 3 }));
 
     alignMatrix.add(decodeGraphAlignment(0, "1[3M]1[3M]1[3M]1[3M]1[3M]2[2M]", &graph), mate);
     alignMatrix.add(decodeGraphAlignment(3, "0[3M]1[3M]1[3M]1[3M]", &graph), mate);
-    ASSERT_EQ(getAlleleCandidates(readLen, motifLen, alignMatrix), unordered_set<int>({ 2, 3, 5 }));
+    ASSERT_EQ(getAlleleCandidates(readLen, motifLen, alignMatrix), vector<int>({ 2, 3, 5 }));
 
     /*
     alignMatrix.add(decodeGraphAlignment(0, "1[3M]1[3M]1[3M]1[3M]1[3M]1[3M]1[3M]1[3M]", &graph), mate);
@@ -84,4 +82,25 @@ TEST(GenotypingStrWithTwoAlleles, TypicalReads_Computed)
     expectedGt.setShortAlleleSizeInUnitsCi(2, 17);
     expectedGt.setLongAlleleSizeInUnitsCi(2, 73);
     EXPECT_EQ(gt, expectedGt);
-}
\ No newline at end of file
+}
+TEST(GenotypingStrWithTwoAlleles, ManyFragments_SameGenotypeOnSeveralThreads)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+
+    AlignMatrix alignMatrix(1);
+    GraphAlignment mate = decodeGraphAlignment(0, "0[6M]", &graph);
+    for (int fragIndex = 0; fragIndex != FragLogliks::kMinFragsForParallelGenotyping; ++fragIndex)
+    {
+        alignMatrix.add(decodeGraphAlignment(3, "0[3M]1[1M]1[1M]2[4M]", &graph), mate);
+        alignMatrix.add(decodeGraphAlignment(3, "0[3M]1[1M]1[1M]1[1M]1[1M]2[4M]", &graph), mate);
+        alignMatrix.add(decodeGraphAlignment(0, "1[1M]1[1M]1[1M]2[4M]", &graph), mate);
+    }
+    AlignMatrix alignMatrixCopy = alignMatrix;
+
+    const int motifLen = 1;
+    const int readLen = 8;
+    const int fragLen = 20;
+    RepeatGenotype expectedGt = genotype(AlleleCount::kTwo, motifLen, readLen, fragLen, alignMatrix);
+    RepeatGenotype gt = genotype(AlleleCount::kTwo, motifLen, readLen, fragLen, alignMatrixCopy, 4);
+    EXPECT_EQ(gt, expectedGt);
+}
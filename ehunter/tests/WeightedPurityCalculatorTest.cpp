@@ -44,3 +44,11 @@ TEST(CalculatingWeightedPurityScore, ImperfectRepeat_Calculated)
     EXPECT_THAT(wpCalculator.score("ACCCCAACCCCAACCCCAACCCCAACCCCAACCCCA"), DoubleNear(1.0, 0.005));
     EXPECT_THAT(wpCalculator.score("tCCCCttCCCCttCCCCttCCCCtTCCCCttCCCCT"), DoubleNear(0.75, 0.005));
 }
+
+TEST(CalculatingWeightedPurityScore, RotatedAndReverseComplementedRepeats_Calculated)
+{
+    WeightedPurityCalculator wpCalculator("CGG");
+    EXPECT_THAT(wpCalculator.score("GGCGGCGGCGGC"), DoubleNear(1.0, 0.005));
+    EXPECT_THAT(wpCalculator.score("CCGCCGCCGCCG"), DoubleNear(1.0, 0.005));
+    EXPECT_THAT(wpCalculator.score("GCCGCCGCCGCA"), DoubleNear(0.833, 0.005));
+}
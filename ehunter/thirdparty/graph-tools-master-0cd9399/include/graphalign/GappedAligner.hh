@@ -25,6 +25,7 @@
 #include <list>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/optional.hpp>
 
@@ -120,6 +121,17 @@ public:
      */
     std::list<GraphAlignment> align(const std::string& query, AlignerSelector& alignerSelector) const;
 
+    /**
+     * Aligns a read to the graph skipping seed lookups for kmers that are known to be absent from the graph
+     *
+     * @param query: Query sequence
+     * @param seed_candidates: Flag for each kmer start on the query; kmers starting at unflagged positions are assumed
+     * not to occur in the graph
+     * @return List of top-scoring graph alignments
+     */
+    std::list<GraphAlignment> align(
+        const std::string& query, AlignerSelector& alignerSelector, const std::vector<bool>& seed_candidates) const;
+
     /**
      * Extends a seed path corresponding to a perfect match to the query sequence to full-length alignments
      *
@@ -173,7 +185,11 @@ private:
         int start_on_query = -1;
     };
 
-    // Performs a search for an alignment seed
-    boost::optional<AlignmentSeed> searchForAlignmentSeed(const std::string& query) const;
+    std::list<GraphAlignment> alignWithSeedCandidates(
+        const std::string& query, AlignerSelector& alignerSelector, const std::vector<bool>* seed_candidates) const;
+
+    // Performs a search for an alignment seed; kmers at positions not flagged as seed candidates are skipped
+    boost::optional<AlignmentSeed>
+    searchForAlignmentSeed(const std::string& query, const std::vector<bool>* seed_candidates) const;
 };
 }
@@ -39,6 +39,9 @@ namespace graphtools
 /**
  * Represents an alignment of a sequence to a graph. Graph alignment consists of a path and linear alignments for each
  * node of the path.
+ *
+ * Copies of a graph alignment share its contents until one of them is modified, so graph alignments are cheap to copy
+ * and store.
  */
 class GraphAlignment
 {
@@ -46,9 +49,8 @@ public:
     typedef size_t size_type;
     typedef std::vector<Alignment> NodeAlignments;
     typedef NodeAlignments::const_iterator const_iterator;
-    GraphAlignment(const Path& path, const std::vector<Alignment>& alignments)
-        : path_(path)
-        , alignments_(alignments)
+    GraphAlignment(Path path, NodeAlignments alignments)
+        : data_(std::make_shared<Data>(Data{ std::move(path), std::move(alignments) }))
     {
         assertValidity();
     }
@@ -56,9 +58,9 @@ public:
     uint32_t queryLength() const;
     uint32_t referenceLength() const;
     uint32_t numMatches() const;
-    const Path& path() const { return path_; }
+    const Path& path() const { return data_->path; }
     bool overlapsNode(NodeId node_id) const;
-    NodeId getNodeIdByIndex(int32_t node_index) const { return path_.getNodeIdByIndex(node_index); }
+    NodeId getNodeIdByIndex(int32_t node_index) const { return data_->path.getNodeIdByIndex(node_index); }
     std::list<int32_t> getIndexesOfNode(NodeId node_id) const;
 
     // Removes the specified number of reference bases from the beginning of the alignment while softclipping as many
@@ -69,16 +71,17 @@ public:
     // bases as required
     void shrinkEnd(int reference_length);
 
-    const_iterator begin() const { return alignments_.begin(); }
-    const_iterator end() const { return alignments_.end(); }
-    const Alignment& front() const { return alignments_.front(); }
-    const Alignment& back() const { return alignments_.back(); }
-    size_type size() const { return alignments_.size(); }
-    const Alignment& operator[](size_t index) const { return alignments_[index]; }
-    const std::vector<Alignment>& alignments() const { return alignments_; }
+    const_iterator begin() const { return data_->alignments.begin(); }
+    const_iterator end() const { return data_->alignments.end(); }
+    const Alignment& front() const { return data_->alignments.front(); }
+    const Alignment& back() const { return data_->alignments.back(); }
+    size_type size() const { return data_->alignments.size(); }
+    const Alignment& operator[](size_t index) const { return data_->alignments[index]; }
+    const std::vector<Alignment>& alignments() const { return data_->alignments; }
     bool operator==(const GraphAlignment& other) const
     {
-        return path_ == other.path_ && alignments_ == other.alignments_;
+        return data_ == other.data_
+            || (data_->path == other.data_->path && data_->alignments == other.data_->alignments);
     }
     bool operator<(const GraphAlignment& other) const;
     std::string generateCigar() const;
@@ -86,9 +89,17 @@ public:
     friend std::ostream& operator<<(std::ostream& os, const GraphAlignment& graph_alignment);
 
 private:
+    struct Data
+    {
+        Path path;
+        NodeAlignments alignments;
+    };
+
     void assertValidity() const;
-    Path path_;
-    std::vector<Alignment> alignments_;
+    // Returns contents that are not shared with any other copy
+    Data& mutableData();
+
+    std::shared_ptr<Data> data_;
 };
 
 std::ostream& operator<<(std::ostream& os, const GraphAlignment& graph_alignment);
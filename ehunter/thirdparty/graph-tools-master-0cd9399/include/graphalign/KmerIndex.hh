@@ -27,14 +27,20 @@
 
 #include "graphcore/Graph.hh"
 #include "graphcore/Path.hh"
+#include "graphutils/KmerEncoding.hh"
 
 namespace graphtools
 {
 
 // Kmer index holds paths that correspond to each kmer that appears in the graph and supports a few standard operations.
+//
+// Kmers are stored in a flat open-addressed table keyed by their two-bit encodings (see TwoBitKmerEncoder). Lookups
+// by encoded kmer avoid per-kmer string construction and are intended for use with TwoBitEncodedKmers.
 class KmerIndex
 {
 public:
+    using KmerKey_t = TwoBitKmerEncoder::KmerKey_t;
+
     explicit KmerIndex(const Graph& graph, int32_t kmer_len = 12);
     KmerIndex(const KmerIndex& other);
     KmerIndex(KmerIndex&& other) noexcept;
@@ -53,6 +59,17 @@ public:
     std::unordered_set<std::string> kmers() const;
     size_t kmerLength() const;
 
+    /// \brief Lookups by two-bit kmer encoding; the key must encode a kmer of kmerLength()
+    bool containsKey(KmerKey_t kmer_key) const;
+    size_t numPathsForKey(KmerKey_t kmer_key) const;
+    std::vector<Path> getPathsForKey(KmerKey_t kmer_key) const;
+
+    /// \brief Looks up all kmers of an encoded sequence in one batch
+    ///
+    /// On return, num_paths[i] holds the number of paths of the i-th kmer or zero if the kmer is invalid or absent.
+    /// Table slots are prefetched a few kmers ahead of each lookup.
+    void numPathsForKmers(const TwoBitEncodedKmers& kmers, std::vector<uint32_t>& num_paths) const;
+
     size_t numUniqueKmersOverlappingNode(NodeId node_id) const;
     size_t numUniqueKmersOverlappingEdge(NodeId from, NodeId to) const;
 
@@ -20,29 +20,30 @@
 
 #pragma once
 
-#include <list>
 #include <string>
+#include <vector>
 
 #include "graphalign/Operation.hh"
 
 namespace graphtools
 {
 
-// Represents a linear alignment
+// Represents a linear alignment; operations are stored contiguously
 class Alignment
 {
 public:
     using size_type = size_t;
-    using const_iterator = std::list<Operation>::const_iterator;
+    using Operations = std::vector<Operation>;
+    using const_iterator = Operations::const_iterator;
 
-    Alignment(int32_t reference_start, std::list<Operation> operations)
+    Alignment(int32_t reference_start, Operations operations)
         : reference_start_(reference_start)
         , operations_(std::move(operations))
     {
         updateCounts();
     }
     Alignment(uint32_t reference_start, const std::string& cigar);
-    const std::list<Operation>& operations() const { return operations_; }
+    const Operations& operations() const { return operations_; }
     size_type numOperations() const { return operations_.size(); }
     uint32_t queryLength() const;
     uint32_t referenceLength() const;
@@ -86,14 +87,14 @@ protected:
     void updateCounts();
 
 private:
-    size_t matched_ = 0;
-    size_t mismatched_ = 0;
-    size_t clipped_ = 0;
-    size_t inserted_ = 0;
-    size_t deleted_ = 0;
-    size_t missing_ = 0;
+    uint32_t matched_ = 0;
+    uint32_t mismatched_ = 0;
+    uint32_t clipped_ = 0;
+    uint32_t inserted_ = 0;
+    uint32_t deleted_ = 0;
+    uint32_t missing_ = 0;
     int32_t reference_start_ = 0;
-    std::list<Operation> operations_;
+    Operations operations_;
 };
 
 std::ostream& operator<<(std::ostream& os, const Alignment& alignment);
@@ -36,17 +36,25 @@ enum class OperationType
 };
 
 // Represents a single alignment operation
+// Operations are packed into 32 bits (3 bits of type and 29 bits of length) so that the operations of an alignment
+// occupy a small contiguous buffer
 class Operation
 {
 public:
+    static const uint32_t kMaxLength = (1u << 29) - 1;
+
     Operation(OperationType type, uint32_t length)
-        : type_(type)
+        : type_(static_cast<uint32_t>(type))
         , length_(length)
     {
+        if (length > kMaxLength)
+        {
+            throwLengthError(length);
+        }
     }
     explicit Operation(std::string cigar);
 
-    OperationType type() const { return type_; }
+    OperationType type() const { return static_cast<OperationType>(type_); }
     uint32_t length() const { return length_; }
     uint32_t referenceLength() const;
     uint32_t queryLength() const;
@@ -57,10 +65,14 @@ public:
     std::string generateCigar() const;
 
 private:
-    OperationType type_;
-    uint32_t length_;
+    [[noreturn]] static void throwLengthError(uint32_t length);
+
+    uint32_t type_ : 3;
+    uint32_t length_ : 29;
 };
 
+static_assert(sizeof(Operation) == sizeof(uint32_t), "Operations are expected to be packed");
+
 OperationType decodeOperationType(char type_encoding);
 
 std::ostream& operator<<(std::ostream& os, OperationType operation_type);
@@ -22,6 +22,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "graphalign/LinearAlignment.hh"
 #include "graphalign/TracebackMatrix.hh"
@@ -42,6 +43,10 @@ public:
     {
     }
     TracebackMatrix populateTracebackMatrix(const std::string& reference, const std::string& query);
+    // Finds the cell that prefixAlign traces back from (the last top-scoring cell in row-major order) in a score-only
+    // pass that keeps a single row of the matrix
+    void locateTopScoringCell(
+        const std::string& reference, const std::string& query, size_t& top_row_index, size_t& top_col_index);
     // Calculates a top-scoring local alignment of a query to the reference that starts at left-most position of both
     // sequences
     Alignment prefixAlign(const std::string& reference, const std::string& query);
@@ -59,5 +64,7 @@ private:
     int32_t match_score_;
     int32_t mismatch_score_;
     int32_t gap_score_;
+
+    std::vector<int32_t> row_scores_;
 };
 }
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <list>
 #include <map>
 #include <string>
@@ -73,7 +74,7 @@ class PinnedDagAligner
     typedef graphalign::dagAligner::Cigar Cigar;
     BaseMatchingDagAligner<true, false> aligner_;
 
-    static void appendOperation(OperationType type, uint32_t length, std::list<Operation>& operations)
+    static void appendOperation(OperationType type, uint32_t length, Alignment::Operations& operations)
     {
         if (operations.empty() || operations.back().type() != type)
         {
@@ -87,7 +88,7 @@ class PinnedDagAligner
 
     template <typename GraphT, typename PathT>
     static void parseGraphCigar(
-        const GraphT& graph, const graphalign::dagAligner::Cigar& cigar, PathT& path, std::list<Operation>& operations)
+        const GraphT& graph, const graphalign::dagAligner::Cigar& cigar, PathT& path, Alignment::Operations& operations)
     {
         using namespace graphalign::dagAligner;
         for (const Cigar::Operation& op : cigar)
@@ -231,10 +232,10 @@ public:
                 unmapNodeIds(originalIds, cigar);
 
                 Path path = seedPath;
-                std::list<Operation> operations;
+                Alignment::Operations operations;
                 parseGraphCigar(*seedPath.graphRawPtr(), cigar, path, operations);
 
-                ret.push_back(PathAndAlignment(path, Alignment(seedPath.seq().length(), operations)));
+                ret.push_back(PathAndAlignment(path, Alignment(seedPath.seq().length(), std::move(operations))));
             }
         }
 
@@ -281,13 +282,13 @@ public:
 
                 Path path = seedPath;
                 ReversePath rp(path);
-                std::list<Operation> operations;
+                Alignment::Operations operations;
                 parseGraphCigar(rg, cigar, rp, operations);
-                operations.reverse();
+                std::reverse(operations.begin(), operations.end());
 
                 // reversed alignments always start at the beginning of the path because
                 // the seed path gets start-extended to incorporate them
-                ret.push_back(PathAndAlignment(path, Alignment(0, operations)));
+                ret.push_back(PathAndAlignment(path, Alignment(0, std::move(operations))));
             }
         }
 
@@ -20,8 +20,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <list>
 #include <string>
+#include <vector>
 
 #include "graphalign/GraphAlignment.hh"
 #include "graphalign/LinearAlignmentOperations.hh"
@@ -33,6 +35,14 @@ namespace graphtools
 
 using PathAndAlignment = std::pair<Path, Alignment>;
 
+/**
+ * Aligns query pieces to all extensions of a seed path and reports the top-scoring extensions
+ *
+ * Extensions are scored in one depth-first pass over the graph: the dynamic programming columns computed for the
+ * reference bases shared by several extensions are reused by all of them, and subtrees that cannot reach the best
+ * score found so far are skipped. Only the top-scoring extensions are then aligned with traceback. The results are
+ * identical to aligning the query to each path returned by extendPathStart / extendPathEnd in turn.
+ */
 class PinnedPathAligner
 {
     const int32_t matchScore_;
@@ -55,63 +65,33 @@ public:
     prefixAlign(const Path& seed_path, const std::string& query_piece, size_t extension_len, int& score) const;
 
 private:
-    int32_t scoreAlignment(const Alignment& alignment) const
+    struct ExtensionSearch
     {
-        return graphtools::scoreAlignment(alignment, matchScore_, mismatchScore_, gapOpenScore_);
-    }
-};
-
-inline std::list<PathAndAlignment> PinnedPathAligner::suffixAlign(
-    const Path& seed_path, const std::string& query_piece, size_t extension_len, int& top_alignment_score) const
-{
-    std::list<PathAndAlignment> top_paths_and_alignments;
-    top_alignment_score = INT32_MIN;
-
-    const std::list<Path> path_extensions = extendPathStart(seed_path, extension_len);
-    for (const auto& path : path_extensions)
-    {
-        Alignment alignment = pinnedAligner_.suffixAlign(path.seq(), query_piece);
-        const int32_t alignment_score = scoreAlignment(alignment);
-
-        if (top_alignment_score < alignment_score)
-        {
-            top_paths_and_alignments.clear();
-            top_alignment_score = alignment_score;
-        }
-
-        if (top_alignment_score == alignment_score)
-        {
-            top_paths_and_alignments.push_back(std::make_pair(path, alignment));
-        }
-    }
+        bool extend_start;
+        int32_t top_score;
+        std::list<Path> top_paths;
+    };
+
+    std::list<Path> findTopScoringExtensions(
+        const Path& seed_path, const std::string& query_piece, size_t extension_len, bool extend_start,
+        int32_t& top_score) const;
+    void searchExtensions(
+        ExtensionSearch& search, const Path& path, int32_t extension_len, size_t depth, size_t column_index,
+        int32_t path_top_score) const;
+    void initializeColumn(const std::string& query) const;
+    void advanceColumn(size_t depth, char reference_base, size_t column_index, int32_t& top_score) const;
+    bool checkIfScoreIsReachable(size_t depth, int32_t extension_len, int32_t path_top_score, int32_t score) const;
 
-    return top_paths_and_alignments;
-}
-
-inline std::list<PathAndAlignment> PinnedPathAligner::prefixAlign(
-    const Path& seed_path, const std::string& query_piece, size_t extension_len, int& top_alignment_score) const
-{
-    std::list<PathAndAlignment> top_paths_and_alignments;
-    top_alignment_score = INT32_MIN;
-
-    const std::list<Path> path_extensions = extendPathEnd(seed_path, extension_len);
-    for (const auto& path : path_extensions)
+    int32_t scoreAlignment(const Alignment& alignment) const
     {
-        Alignment alignment = pinnedAligner_.prefixAlign(path.seq(), query_piece);
-        const int32_t alignment_score = scoreAlignment(alignment);
-
-        if (top_alignment_score < alignment_score)
-        {
-            top_paths_and_alignments.clear();
-            top_alignment_score = alignment_score;
-        }
-
-        if (top_alignment_score == alignment_score)
-        {
-            top_paths_and_alignments.push_back(std::make_pair(path, alignment));
-        }
+        return graphtools::scoreAlignment(alignment, matchScore_, mismatchScore_, gapOpenScore_);
     }
 
-    return top_paths_and_alignments;
-}
+    // Scratch space reused between calls: substitution scores of each query base against each reference base code
+    // and the score columns of the extension currently being explored (one per depth of the search)
+    mutable size_t numRows_ = 0;
+    mutable std::vector<int32_t> queryProfile_;
+    mutable std::vector<std::vector<int32_t>> columns_;
+    mutable std::vector<int32_t> nextColumn_;
+};
 }
@@ -36,6 +36,14 @@ class TracebackRunner
 public:
     explicit TracebackRunner(const TracebackMatrix& matrix)
         : matrix_(matrix)
+        , query_len_(matrix.numRows() - 1)
+    {
+    }
+
+    // The matrix may cover only a prefix of the query; query bases past the traceback start are softclipped
+    TracebackRunner(const TracebackMatrix& matrix, size_t query_len)
+        : matrix_(matrix)
+        , query_len_(query_len)
     {
     }
 
@@ -50,8 +58,9 @@ private:
     void softclipQueryPrefix(size_t& row_index);
 
     const TracebackMatrix& matrix_;
+    const size_t query_len_;
 
-    std::list<Operation> operations_;
+    Alignment::Operations operations_;
     TracebackStep run_traceback_step;
     size_t run_length = 0;
     size_t run_last_row_index = 0;
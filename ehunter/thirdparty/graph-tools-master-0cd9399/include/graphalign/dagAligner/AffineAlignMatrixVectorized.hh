@@ -43,9 +43,11 @@ namespace dagAligner
         const Score gapExt_;
 
         PaddedAlignMatrix<step> v_;
-        PaddedAlignMatrix<step> g_;
         PaddedAlignMatrix<step> f_;
         PaddedAlignMatrix<step> e_;
+        // best match/mismatch scores of the column being filled. Backtracking only needs v_, f_ and e_, so this one
+        // is kept for a single column rather than for the whole matrix
+        std::vector<Score> g_;
 
         std::vector<typename PenaltyMatrix::QueryChar> query_;
         std::vector<typename PenaltyMatrix::TargetChar> target_;
@@ -160,7 +162,7 @@ namespace dagAligner
             }
 
             v_.reset(qLen, tLen);
-            g_.reset(qLen, tLen);
+            g_.resize((qLen + step - 1) / step * step);
             f_.reset(qLen, tLen);
             e_.reset(qLen, tLen);
 
@@ -169,10 +171,6 @@ namespace dagAligner
             {
                 throw std::logic_error("Incorrectly initialized v_");
             }
-            if (g_.at(-1, -1))
-            {
-                throw std::logic_error("Incorrectly initialized g_");
-            }
             if (f_.at(-1, -1))
             {
                 throw std::logic_error("Incorrectly initialized f_");
@@ -220,6 +218,7 @@ namespace dagAligner
             {
                 const typename PenaltyMatrix::TargetChar tc = target_[t];
                 const Score* const penalties = &alignmentPenalties_[tc].front();
+                std::fill(g_.begin(), g_.end(), SCORE_MIN);
                 for (EdgeMap::OffsetEdges::const_iterator prevNodeIndexIt = edgeMap.prevNodesBegin(t);
                      edgeMap.prevNodesEnd(t) != prevNodeIndexIt; ++prevNodeIndexIt)
                 {
@@ -227,7 +226,7 @@ namespace dagAligner
                     for (int q = 0; q < qLen; q += step)
                     {
                         recomputeForDeletion(q, t, p);
-                        recomputeForAlign(q, t, p, penalties + q);
+                        recomputeForAlign(q, p, penalties + q);
                     }
                 }
 
@@ -250,7 +249,7 @@ namespace dagAligner
         }
 
         // __attribute((noinline))
-        void recomputeForAlign(int q, int t, int p, const Score penalties[step])
+        void recomputeForAlign(int q, int p, const Score penalties[step])
         {
             Score tmp[step];
             Score* v = v_.row(q - 1, p);
@@ -259,7 +258,7 @@ namespace dagAligner
                 tmp[i] = v[i] + penalties[i];
             }
 
-            Score* g = g_.row(q, t);
+            Score* g = &g_[q];
             for (int i = 0; i < step; ++i)
             {
                 g[i] = g[i] > tmp[i] ? g[i] : tmp[i];
@@ -317,7 +316,7 @@ namespace dagAligner
         {
             Score tmp[step];
             Score* e = e_.row(q, t);
-            Score* g = g_.row(q, t);
+            const Score* g = &g_[q];
             for (int i = 0; i < step; ++i)
             {
                 tmp[i] = g[i] > e[i] ? g[i] : e[i];
@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace graphtools
 {
@@ -100,4 +101,99 @@ private:
     static BaseToIndex baseToIndex_;
     size_t kmerLength_;
 };
+
+/**
+ * Two-bit encoder of a sliding kmer window on both strands of a sequence
+ *
+ * Bases are added one at a time; after each addition the encoder holds the keys of the last kmerLength bases and of
+ * their reverse complement. Lowercase bases are encoded as their uppercase counterparts and a kmer is valid only if all
+ * of its bases are A, C, G, or T. No allocations are made, so the encoder is suitable for per-read scans.
+ */
+class RollingTwoBitKmerEncoder
+{
+public:
+    using KmerKey_t = TwoBitKmerEncoder::KmerKey_t;
+
+    explicit RollingTwoBitKmerEncoder(size_t kmerLength);
+
+    // Slides the window by one base; returns true if the window now holds a valid kmer
+    bool addBase(const char base)
+    {
+        const uint8_t code = baseToCode(base);
+        if (code == kInvalidBaseCode)
+        {
+            reset();
+            return false;
+        }
+
+        forwardKey_ = ((forwardKey_ << 2) | code) & keyMask_;
+        reverseComplementKey_ = (reverseComplementKey_ >> 2) | (static_cast<KmerKey_t>(3 - code) << reverseShift_);
+        if (numValidBases_ < kmerLength_)
+        {
+            ++numValidBases_;
+        }
+        return numValidBases_ == kmerLength_;
+    }
+
+    void reset()
+    {
+        forwardKey_ = 0;
+        reverseComplementKey_ = 0;
+        numValidBases_ = 0;
+    }
+
+    size_t kmerLength() const { return kmerLength_; }
+    KmerKey_t forwardKey() const { return forwardKey_; }
+    KmerKey_t reverseComplementKey() const { return reverseComplementKey_; }
+
+    // Two-bit code of a base (0-3 for ACGT in either case) or kInvalidBaseCode for any other symbol
+    static uint8_t baseToCode(const char base) { return baseToCode_.table[static_cast<uint8_t>(base)]; }
+    static const uint8_t kInvalidBaseCode = 4;
+
+private:
+    struct BaseToCode
+    {
+        BaseToCode();
+        uint8_t table[256];
+    };
+
+    static BaseToCode baseToCode_;
+    size_t kmerLength_;
+    KmerKey_t keyMask_;
+    unsigned reverseShift_;
+    KmerKey_t forwardKey_ = 0;
+    KmerKey_t reverseComplementKey_ = 0;
+    size_t numValidBases_ = 0;
+};
+
+/**
+ * Two-bit encodings of all kmers of a sequence and of their reverse complements
+ *
+ * The encodings are computed in a single rolling pass over the sequence. Kmers are indexed by their start position on
+ * the sequence; the reverse-complement key at a given position encodes the reverse complement of the kmer starting
+ * there, so scanning the reverse-complemented sequence left-to-right corresponds to visiting positions right-to-left.
+ * Lowercase bases are encoded as their uppercase counterparts; kmers overlapping any other symbol are invalid.
+ */
+class TwoBitEncodedKmers
+{
+public:
+    using KmerKey_t = TwoBitKmerEncoder::KmerKey_t;
+
+    explicit TwoBitEncodedKmers(size_t kmerLength);
+
+    // Re-encodes kmers of a new sequence reusing the existing storage
+    void encode(const std::string& sequence);
+
+    size_t kmerLength() const { return encoder_.kmerLength(); }
+    size_t numKmers() const { return forwardKeys_.size(); }
+    bool isValid(size_t position) const { return isValid_[position] != 0; }
+    KmerKey_t forwardKey(size_t position) const { return forwardKeys_[position]; }
+    KmerKey_t reverseComplementKey(size_t position) const { return reverseComplementKeys_[position]; }
+
+private:
+    RollingTwoBitKmerEncoder encoder_;
+    std::vector<KmerKey_t> forwardKeys_;
+    std::vector<KmerKey_t> reverseComplementKeys_;
+    std::vector<uint8_t> isValid_;
+};
 }
@@ -24,7 +24,6 @@
 #include <algorithm>
 #include <stdexcept>
 
-#include <boost/algorithm/string.hpp>
 #include <boost/optional.hpp>
 
 #include "graphalign/GraphAlignmentOperations.hh"
@@ -98,10 +97,22 @@ static int32_t trimSuffixNearNodeEdge(int32_t requested_trim_len, int32_t min_pa
 }
 
 list<GraphAlignment> GappedGraphAligner::align(const string& query, AlignerSelector& alignerSelector) const
+{
+    return alignWithSeedCandidates(query, alignerSelector, nullptr);
+}
+
+list<GraphAlignment> GappedGraphAligner::align(
+    const string& query, AlignerSelector& alignerSelector, const std::vector<bool>& seed_candidates) const
+{
+    return alignWithSeedCandidates(query, alignerSelector, &seed_candidates);
+}
+
+list<GraphAlignment> GappedGraphAligner::alignWithSeedCandidates(
+    const string& query, AlignerSelector& alignerSelector, const std::vector<bool>* seed_candidates) const
 {
     try
     {
-        optional<AlignmentSeed> optional_seed = searchForAlignmentSeed(query);
+        optional<AlignmentSeed> optional_seed = searchForAlignmentSeed(query, seed_candidates);
 
         if (optional_seed)
         {
@@ -125,31 +136,46 @@ list<GraphAlignment> GappedGraphAligner::align(const string& query, AlignerSelec
     }
 }
 
-optional<GappedGraphAligner::AlignmentSeed> GappedGraphAligner::searchForAlignmentSeed(const string& query) const
+optional<GappedGraphAligner::AlignmentSeed>
+GappedGraphAligner::searchForAlignmentSeed(const string& query, const std::vector<bool>* seed_candidates) const
 {
-    string upperQuery = query;
-    boost::to_upper(upperQuery);
+    // Kmer encoding and path matching are both case-insensitive, so the query is searched as is
+    TwoBitEncodedKmers query_kmers(kmer_len_);
+    query_kmers.encode(query);
+
+    // All kmers are looked up once; both passes below select seeds from these path counts
+    std::vector<uint32_t> num_kmer_paths;
+    kmer_index_.numPathsForKmers(query_kmers, num_kmer_paths);
+    if (seed_candidates)
+    {
+        const size_t num_candidates = std::min(seed_candidates->size(), num_kmer_paths.size());
+        for (size_t kmer_start = 0; kmer_start != num_candidates; ++kmer_start)
+        {
+            if (!(*seed_candidates)[kmer_start])
+            {
+                num_kmer_paths[kmer_start] = 0;
+            }
+        }
+    }
 
     optional<GappedGraphAligner::AlignmentSeed> optional_seed;
 
     bool found_multipath_kmer = false;
     size_t kmer_start_position = 0;
-    while (kmer_start_position + kmer_len_ <= upperQuery.length())
+    while (kmer_start_position < num_kmer_paths.size())
     {
-        const string kmer = upperQuery.substr(kmer_start_position, static_cast<size_t>(kmer_len_));
-
         // Initiate seed construction from a unique kmer
-        auto num_kmer_paths = kmer_index_.numPaths(kmer);
-        if (num_kmer_paths > 1)
+        const uint32_t num_paths = num_kmer_paths[kmer_start_position];
+        if (num_paths > 1)
         {
             found_multipath_kmer = true;
         }
 
-        if (num_kmer_paths == 1)
+        if (num_paths == 1)
         {
-            const Path kmer_path = kmer_index_.getPaths(kmer).front();
+            const Path kmer_path = kmer_index_.getPathsForKey(query_kmers.forwardKey(kmer_start_position)).front();
             // This call updates kmer_start_position to the start of the extended path
-            Path extended_path = extendPathMatching(kmer_path, upperQuery, kmer_start_position);
+            Path extended_path = extendPathMatching(kmer_path, query, kmer_start_position);
 
             if (!optional_seed || extended_path.length() > optional_seed->path.length())
             {
@@ -170,21 +196,19 @@ optional<GappedGraphAligner::AlignmentSeed> GappedGraphAligner::searchForAlignme
     }
 
     // If the search for unique kmer failed, consider kmers that correspond to multiple paths
-    const int kMaxPathCount = 10;
+    const uint32_t kMaxPathCount = 10;
     kmer_start_position = 0;
-    while (kmer_start_position + kmer_len_ <= upperQuery.length())
+    while (kmer_start_position < num_kmer_paths.size())
     {
-        const string kmer = upperQuery.substr(kmer_start_position, static_cast<size_t>(kmer_len_));
-
-        const int numPaths = kmer_index_.numPaths(kmer);
-        if (0 < numPaths && numPaths <= kMaxPathCount)
+        const uint32_t num_paths = num_kmer_paths[kmer_start_position];
+        if (0 < num_paths && num_paths <= kMaxPathCount)
         {
             size_t longest_kmer_path_extension = 0;
             size_t kmer_start_position_for_longest_extension = 0;
-            for (const Path& kmer_path : kmer_index_.getPaths(kmer))
+            for (const Path& kmer_path : kmer_index_.getPathsForKey(query_kmers.forwardKey(kmer_start_position)))
             {
                 size_t kmer_start_position_for_kmer_path = kmer_start_position;
-                Path extended_path = extendPathMatching(kmer_path, upperQuery, kmer_start_position_for_kmer_path);
+                Path extended_path = extendPathMatching(kmer_path, query, kmer_start_position_for_kmer_path);
 
                 if (longest_kmer_path_extension < extended_path.length())
                 {
@@ -33,24 +33,37 @@ using std::to_string;
 
 namespace graphtools
 {
+GraphAlignment::Data& GraphAlignment::mutableData()
+{
+    if (data_.use_count() > 1)
+    {
+        data_ = std::make_shared<Data>(*data_);
+    }
+    return *data_;
+}
+
 void GraphAlignment::assertValidity() const
 {
-    for (size_t node_index = 0; node_index != path_.numNodes(); ++node_index)
+    const Path& alignment_path = data_->path;
+    const NodeAlignments& node_alignments = data_->alignments;
+
+    for (size_t node_index = 0; node_index != alignment_path.numNodes(); ++node_index)
     {
-        const Alignment& node_alignment = alignments_[node_index];
+        const Alignment& node_alignment = node_alignments[node_index];
 
         const bool is_start_wrong
-            = path_.getStartPositionOnNodeByIndex(node_index) != (int32_t)node_alignment.referenceStart();
+            = alignment_path.getStartPositionOnNodeByIndex(node_index) != (int32_t)node_alignment.referenceStart();
 
         const int32_t node_alignment_end = node_alignment.referenceLength() + node_alignment.referenceStart();
-        const bool is_end_wrong = path_.getEndPositionOnNodeByIndex(node_index) != node_alignment_end;
+        const bool is_end_wrong = alignment_path.getEndPositionOnNodeByIndex(node_index) != node_alignment_end;
 
         if (is_start_wrong || is_end_wrong)
         {
             std::ostringstream graph_alignment_encoding;
             graph_alignment_encoding << *this;
             throw std::logic_error(
-                "Path " + path_.encode() + " is not compatible with graph alignment " + graph_alignment_encoding.str());
+                "Path " + alignment_path.encode() + " is not compatible with graph alignment "
+                + graph_alignment_encoding.str());
         }
     }
 }
@@ -58,7 +71,7 @@ void GraphAlignment::assertValidity() const
 uint32_t GraphAlignment::queryLength() const
 {
     uint32_t query_span = 0;
-    for (const auto& alignment : alignments_)
+    for (const auto& alignment : data_->alignments)
     {
         query_span += alignment.queryLength();
     }
@@ -68,7 +81,7 @@ uint32_t GraphAlignment::queryLength() const
 uint32_t GraphAlignment::referenceLength() const
 {
     uint32_t reference_span = 0;
-    for (const auto& alignment : alignments_)
+    for (const auto& alignment : data_->alignments)
     {
         reference_span += alignment.referenceLength();
     }
@@ -78,7 +91,7 @@ uint32_t GraphAlignment::referenceLength() const
 uint32_t GraphAlignment::numMatches() const
 {
     uint32_t num_matches = 0;
-    for (const auto& alignment : alignments_)
+    for (const auto& alignment : data_->alignments)
     {
         num_matches += alignment.numMatched();
     }
@@ -87,16 +100,17 @@ uint32_t GraphAlignment::numMatches() const
 
 bool GraphAlignment::overlapsNode(NodeId node_id) const
 {
-    return path_.checkOverlapWithNode(static_cast<NodeId>(node_id));
+    return data_->path.checkOverlapWithNode(static_cast<NodeId>(node_id));
 }
 
 list<int32_t> GraphAlignment::getIndexesOfNode(NodeId node_id) const
 {
     list<int32_t> indexes;
-    const auto num_alignments = static_cast<int32_t>(alignments_.size());
+    const Path& alignment_path = data_->path;
+    const auto num_alignments = static_cast<int32_t>(data_->alignments.size());
     for (int32_t node_index = 0; node_index != num_alignments; ++node_index)
     {
-        const NodeId cur_node_id = path_.getNodeIdByIndex(static_cast<size_t>(node_index));
+        const NodeId cur_node_id = alignment_path.getNodeIdByIndex(static_cast<size_t>(node_index));
         if (cur_node_id == node_id)
         {
             indexes.push_back(node_index);
@@ -110,9 +124,9 @@ string GraphAlignment::generateCigar() const
     string graph_cigar;
     for (int32_t index = 0; index != (int32_t)size(); ++index)
     {
-        const int32_t node_id = path_.getNodeIdByIndex(static_cast<size_t>(index));
+        const int32_t node_id = getNodeIdByIndex(index);
         graph_cigar += std::to_string(node_id);
-        const Alignment& alignment = alignments_[index];
+        const Alignment& alignment = data_->alignments[index];
         graph_cigar += "[" + alignment.generateCigar() + "]";
     }
     return graph_cigar;
@@ -120,12 +134,12 @@ string GraphAlignment::generateCigar() const
 
 bool GraphAlignment::operator<(const GraphAlignment& other) const
 {
-    if (!(path_ == other.path_))
+    if (!(path() == other.path()))
     {
-        return path_ < other.path_;
+        return path() < other.path();
     }
 
-    return alignments_ < other.alignments_;
+    return alignments() < other.alignments();
 }
 
 void GraphAlignment::shrinkStart(int reference_length)
@@ -139,11 +153,14 @@ void GraphAlignment::shrinkStart(int reference_length)
         throw std::logic_error(string_stream.str());
     }
 
-    path_.shrinkStartBy(reference_length);
+    Data& data = mutableData();
+    Path& alignment_path = data.path;
+    NodeAlignments& node_alignments = data.alignments;
+    alignment_path.shrinkStartBy(reference_length);
 
     size_t leftover_reference_length = reference_length;
 
-    auto first_suffix_alignment_iter = alignments_.begin();
+    auto first_suffix_alignment_iter = node_alignments.begin();
     while (leftover_reference_length >= first_suffix_alignment_iter->referenceLength())
     {
         leftover_reference_length -= first_suffix_alignment_iter->referenceLength();
@@ -162,7 +179,7 @@ void GraphAlignment::shrinkStart(int reference_length)
     Alignment softclipAlignment(first_suffix_alignment_iter->referenceStart(), to_string(prefix_query_length) + "S");
     *first_suffix_alignment_iter = mergeAlignments(softclipAlignment, *first_suffix_alignment_iter);
 
-    alignments_.erase(alignments_.begin(), first_suffix_alignment_iter);
+    node_alignments.erase(node_alignments.begin(), first_suffix_alignment_iter);
 
     assertValidity();
 }
@@ -178,11 +195,14 @@ void GraphAlignment::shrinkEnd(int reference_length)
         throw std::logic_error(string_stream.str());
     }
 
-    path_.shrinkEndBy(reference_length);
+    Data& data = mutableData();
+    Path& alignment_path = data.path;
+    NodeAlignments& node_alignments = data.alignments;
+    alignment_path.shrinkEndBy(reference_length);
 
     size_t leftover_reference_length = reference_length;
 
-    auto last_prefix_alignment_iter = alignments_.end() - 1;
+    auto last_prefix_alignment_iter = node_alignments.end() - 1;
     while (leftover_reference_length >= last_prefix_alignment_iter->referenceLength())
     {
         leftover_reference_length -= last_prefix_alignment_iter->referenceLength();
@@ -203,7 +223,7 @@ void GraphAlignment::shrinkEnd(int reference_length)
     Alignment softclip_alignment(last_prefix_alignment_reference_end, to_string(suffix_query_length) + "S");
     *last_prefix_alignment_iter = mergeAlignments(*last_prefix_alignment_iter, softclip_alignment);
 
-    alignments_.erase(last_prefix_alignment_iter + 1, alignments_.end());
+    node_alignments.erase(last_prefix_alignment_iter + 1, node_alignments.end());
 
     assertValidity();
 }
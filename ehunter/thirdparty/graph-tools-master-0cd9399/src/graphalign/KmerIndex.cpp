@@ -22,16 +22,16 @@
 #include "graphalign/KmerIndex.hh"
 
 #include <iostream>
+#include <limits>
 #include <list>
+#include <stdexcept>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include <boost/algorithm/string/join.hpp>
-#include <sparsepp/spp.h>
 
 #include "graphcore/PathOperations.hh"
-#include "graphutils/KmerEncoding.hh"
 #include "graphutils/PairHashing.hh"
 #include "graphutils/SequenceOperations.hh"
 
@@ -43,23 +43,41 @@ using std::vector;
 namespace graphtools
 {
 
+// Single-node path of kmer length packed into the value of a kmer table slot
 struct MiniPath
 {
-    bool operator==(const MiniPath& other) const
+    using pos_t = uint16_t;
+    using node_t = uint16_t;
+    static const node_t kMaxNodeId = 0x7fff;
+
+    static MiniPath unpack(uint32_t value)
     {
-        return (start_position == other.start_position) and (node_id == other.node_id);
+        return { static_cast<pos_t>(value & 0xffff), static_cast<node_t>(value >> 16) };
     }
+    uint32_t pack() const { return (static_cast<uint32_t>(node_id) << 16) | start_position; }
 
-    using pos_t = uint16_t;
-    using node_t = uint16_t;
     pos_t start_position;
     node_t node_id;
 };
 
-using KmerKey_t = uint32_t;
+using KmerKey_t = KmerIndex::KmerKey_t;
+
+// Slot of the open-addressed kmer table. The value either packs a MiniPath or, if kPathListFlag is set, holds
+// the index of the kmer's path list; eight slots fit into a cache line.
+struct KmerSlot
+{
+    static const uint32_t kEmptyValue = 0xffffffff;
+    static const uint32_t kPathListFlag = 0x80000000;
+
+    bool isEmpty() const { return value == kEmptyValue; }
+    bool holdsPathList() const { return (value & kPathListFlag) != 0; }
+    uint32_t pathListIndex() const { return value & ~kPathListFlag; }
+
+    KmerKey_t key;
+    uint32_t value;
+};
 
-typedef spp::sparse_hash_map<KmerKey_t, MiniPath> StringToMiniPathsMap;
-typedef spp::sparse_hash_map<KmerKey_t, std::vector<Path>> StringToPathsMap;
+static_assert(sizeof(KmerSlot) == 8, "Kmer table slots are expected to be packed");
 
 struct KmerIndex::Impl
 {
@@ -69,22 +87,39 @@ struct KmerIndex::Impl
     void updateKmerCounts();
     Path MiniPathToPath(const MiniPath& miniPath) const;
 
+    // Returns the slot holding the key or the empty slot where it would be inserted
+    size_t homeSlot(KmerKey_t kmer_key) const;
+    size_t findSlot(KmerKey_t kmer_key) const;
+    const KmerSlot* findKmer(KmerKey_t kmer_key) const;
+    void insertKmer(KmerKey_t kmer_key, uint32_t value);
+    void growTable();
+    size_t numPaths(const KmerSlot& slot) const;
+    std::vector<Path> getPaths(const KmerSlot& slot) const;
+
 private:
     const Graph& graph_;
 
 public:
     size_t kmer_len;
     TwoBitKmerEncoder kmer_coder;
-    StringToMiniPathsMap kmer_to_minipaths_map;
-    StringToPathsMap kmer_to_paths_map;
+    std::vector<KmerSlot> kmer_table;
+    unsigned kmer_table_shift;
+    size_t num_kmers;
+    std::vector<std::vector<Path>> path_lists;
     std::unordered_map<NodeId, size_t> node_kmer_counts;
     std::unordered_map<NodeIdPair, size_t> edge_kmer_counts;
 };
 
+const uint32_t KmerSlot::kEmptyValue;
+const uint32_t KmerSlot::kPathListFlag;
+
 KmerIndex::Impl::Impl(const Graph& graph, size_t kmer_len_)
     : graph_(graph)
     , kmer_len(kmer_len_)
     , kmer_coder(kmer_len)
+    , kmer_table(16, KmerSlot{ 0, KmerSlot::kEmptyValue })
+    , kmer_table_shift(32 - 4)
+    , num_kmers(0)
 {
     for (NodeId node_id = 0; node_id != graph.numNodes(); ++node_id)
     {
@@ -93,6 +128,70 @@ KmerIndex::Impl::Impl(const Graph& graph, size_t kmer_len_)
     updateKmerCounts();
 }
 
+size_t KmerIndex::Impl::homeSlot(KmerKey_t kmer_key) const
+{
+    // Fibonacci hashing spreads the structured two-bit keys over the power-of-two table
+    return static_cast<uint32_t>(kmer_key * 2654435769u) >> kmer_table_shift;
+}
+
+size_t KmerIndex::Impl::findSlot(KmerKey_t kmer_key) const
+{
+    const size_t mask = kmer_table.size() - 1;
+    size_t slot_index = homeSlot(kmer_key);
+    while (!kmer_table[slot_index].isEmpty() && kmer_table[slot_index].key != kmer_key)
+    {
+        slot_index = (slot_index + 1) & mask;
+    }
+    return slot_index;
+}
+
+const KmerSlot* KmerIndex::Impl::findKmer(KmerKey_t kmer_key) const
+{
+    const KmerSlot& slot = kmer_table[findSlot(kmer_key)];
+    return slot.isEmpty() ? nullptr : &slot;
+}
+
+void KmerIndex::Impl::insertKmer(KmerKey_t kmer_key, uint32_t value)
+{
+    // Keep the load factor at or below 1/2 so that probe sequences stay short
+    if (2 * (num_kmers + 1) > kmer_table.size())
+    {
+        growTable();
+    }
+    KmerSlot& slot = kmer_table[findSlot(kmer_key)];
+    slot.key = kmer_key;
+    slot.value = value;
+    ++num_kmers;
+}
+
+void KmerIndex::Impl::growTable()
+{
+    std::vector<KmerSlot> old_table(2 * kmer_table.size(), KmerSlot{ 0, KmerSlot::kEmptyValue });
+    old_table.swap(kmer_table);
+    --kmer_table_shift;
+    for (const KmerSlot& old_slot : old_table)
+    {
+        if (!old_slot.isEmpty())
+        {
+            kmer_table[findSlot(old_slot.key)] = old_slot;
+        }
+    }
+}
+
+size_t KmerIndex::Impl::numPaths(const KmerSlot& slot) const
+{
+    return slot.holdsPathList() ? path_lists[slot.pathListIndex()].size() : 1;
+}
+
+std::vector<Path> KmerIndex::Impl::getPaths(const KmerSlot& slot) const
+{
+    if (slot.holdsPathList())
+    {
+        return path_lists[slot.pathListIndex()];
+    }
+    return { MiniPathToPath(MiniPath::unpack(slot.value)) };
+}
+
 void KmerIndex::Impl::addKmerPathsStartingAtNode(NodeId node_id)
 {
     const string node_seq = graph_.nodeSeq(node_id);
@@ -119,36 +218,36 @@ void KmerIndex::Impl::addKmerPaths(const list<Path>& kmer_paths)
         for (const auto& expanded_kmer_seq : expanded_sequences)
         {
             const auto expanded_kmer_key = kmer_coder.encode(expanded_kmer_seq);
-            auto pathIter(kmer_to_paths_map.find(expanded_kmer_key));
-            if (pathIter != kmer_to_paths_map.end())
+            KmerSlot& slot = kmer_table[findSlot(expanded_kmer_key)];
+            if (!slot.isEmpty())
             {
-                pathIter->second.push_back(kmer_path);
+                if (slot.holdsPathList())
+                {
+                    path_lists[slot.pathListIndex()].push_back(kmer_path);
+                }
+                else
+                {
+                    const MiniPath miniPath = MiniPath::unpack(slot.value);
+                    slot.value = KmerSlot::kPathListFlag | static_cast<uint32_t>(path_lists.size());
+                    path_lists.push_back({ MiniPathToPath(miniPath), kmer_path });
+                }
                 continue;
             }
 
-            auto miniPathIter(kmer_to_minipaths_map.find(expanded_kmer_key));
-            if (miniPathIter != kmer_to_minipaths_map.end())
+            if ((kmer_path.numNodes() == 1)
+                and ((kmer_path.endPosition() - kmer_path.startPosition()) == static_cast<int>(kmer_len))
+                and (kmer_path.startPosition() >= 0)
+                and (kmer_path.startPosition() <= std::numeric_limits<MiniPath::pos_t>::max())
+                and (kmer_path.nodeIds().front() <= MiniPath::kMaxNodeId))
             {
-                kmer_to_paths_map[expanded_kmer_key] = { MiniPathToPath(miniPathIter->second), kmer_path };
-                kmer_to_minipaths_map.erase(miniPathIter);
+                MiniPath miniPath{ static_cast<MiniPath::pos_t>(kmer_path.startPosition()),
+                                   static_cast<MiniPath::node_t>(kmer_path.nodeIds().front()) };
+                insertKmer(expanded_kmer_key, miniPath.pack());
             }
             else
             {
-                if ((kmer_path.numNodes() == 1)
-                    and ((kmer_path.endPosition() - kmer_path.startPosition()) == static_cast<int>(kmer_len))
-                    and (kmer_path.startPosition() >= 0)
-                    and (kmer_path.startPosition() <= std::numeric_limits<MiniPath::pos_t>::max())
-                    and (kmer_path.nodeIds().front() <= std::numeric_limits<MiniPath::node_t>::max()))
-                {
-                    MiniPath miniPath{ static_cast<MiniPath::pos_t>(kmer_path.startPosition()),
-                                       static_cast<MiniPath::node_t>(kmer_path.nodeIds().front()) };
-                    kmer_to_minipaths_map.emplace(expanded_kmer_key, miniPath);
-                    continue;
-                }
-                else
-                {
-                    kmer_to_paths_map[expanded_kmer_key] = { kmer_path };
-                }
+                insertKmer(expanded_kmer_key, KmerSlot::kPathListFlag | static_cast<uint32_t>(path_lists.size()));
+                path_lists.push_back({ kmer_path });
             }
         }
     }
@@ -158,20 +257,26 @@ void KmerIndex::Impl::updateKmerCounts()
 {
     node_kmer_counts.clear();
     edge_kmer_counts.clear();
-    for (const auto& kmer_and_paths : kmer_to_minipaths_map)
+    for (const KmerSlot& slot : kmer_table)
     {
-        auto const path_node_id(kmer_and_paths.second.node_id);
-        node_kmer_counts[path_node_id] += 1;
-    }
+        if (slot.isEmpty())
+        {
+            continue;
+        }
 
-    for (const auto& kmer_and_paths : kmer_to_paths_map)
-    {
+        if (!slot.holdsPathList())
+        {
+            node_kmer_counts[MiniPath::unpack(slot.value).node_id] += 1;
+            continue;
+        }
+
+        const std::vector<Path>& paths = path_lists[slot.pathListIndex()];
         // kmer is unique
-        if (kmer_and_paths.second.size() == 1)
+        if (paths.size() == 1)
         {
             bool has_previous = false;
             NodeId previous_node = 0;
-            for (auto const& path_node_id : kmer_and_paths.second.front().nodeIds())
+            for (auto const& path_node_id : paths.front().nodeIds())
             {
                 node_kmer_counts[path_node_id] += 1;
                 if (has_previous)
@@ -219,9 +324,24 @@ KmerIndex::~KmerIndex() = default;
 
 bool KmerIndex::operator==(const KmerIndex& other) const
 {
-    return (
-        pimpl_->kmer_to_minipaths_map == other.pimpl_->kmer_to_minipaths_map
-        and pimpl_->kmer_to_paths_map == other.pimpl_->kmer_to_paths_map && pimpl_->kmer_len == other.pimpl_->kmer_len);
+    if (pimpl_->kmer_len != other.pimpl_->kmer_len or pimpl_->num_kmers != other.pimpl_->num_kmers)
+    {
+        return false;
+    }
+
+    for (const KmerSlot& slot : pimpl_->kmer_table)
+    {
+        if (slot.isEmpty())
+        {
+            continue;
+        }
+        const KmerSlot* other_slot = other.pimpl_->findKmer(slot.key);
+        if (!other_slot or pimpl_->getPaths(slot) != other.pimpl_->getPaths(*other_slot))
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 static string encodePaths(const std::vector<Path>& paths)
@@ -239,15 +359,13 @@ size_t KmerIndex::kmerLength() const { return pimpl_->kmer_len; }
 string KmerIndex::encode() const
 {
     std::vector<string> kv_encodings;
-    for (const auto& kv : pimpl_->kmer_to_minipaths_map)
+    for (const KmerSlot& slot : pimpl_->kmer_table)
     {
-        const string encoding_of_paths = encodePaths({ pimpl_->MiniPathToPath(kv.second) });
-        kv_encodings.emplace_back("{" + pimpl_->kmer_coder.decode(kv.first) + "->" + encoding_of_paths + "}");
-    }
-    for (const auto& kv : pimpl_->kmer_to_paths_map)
-    {
-        const string encoding_of_paths = encodePaths(kv.second);
-        kv_encodings.emplace_back("{" + pimpl_->kmer_coder.decode(kv.first) + "->" + encoding_of_paths + "}");
+        if (!slot.isEmpty())
+        {
+            const string encoding_of_paths = encodePaths(pimpl_->getPaths(slot));
+            kv_encodings.emplace_back("{" + pimpl_->kmer_coder.decode(slot.key) + "->" + encoding_of_paths + "}");
+        }
     }
     return boost::algorithm::join(kv_encodings, ",");
 }
@@ -259,10 +377,7 @@ bool KmerIndex::contains(const std::string& kmer) const
         return false;
     }
 
-    const auto kmer_key = pimpl_->kmer_coder.encode(kmer);
-    return (
-        (pimpl_->kmer_to_minipaths_map.find(kmer_key) != pimpl_->kmer_to_minipaths_map.end())
-        or (pimpl_->kmer_to_paths_map.find(kmer_key) != pimpl_->kmer_to_paths_map.end()));
+    return containsKey(pimpl_->kmer_coder.encode(kmer));
 }
 
 size_t KmerIndex::numPaths(const std::string& kmer) const
@@ -272,51 +387,71 @@ size_t KmerIndex::numPaths(const std::string& kmer) const
         return 0;
     }
 
-    const auto kmer_key = pimpl_->kmer_coder.encode(kmer);
-    if (pimpl_->kmer_to_minipaths_map.find(kmer_key) != pimpl_->kmer_to_minipaths_map.end())
-    {
-        return 1;
-    }
-    else
-    {
-        const auto pathIter(pimpl_->kmer_to_paths_map.find(kmer_key));
-        if (pathIter == pimpl_->kmer_to_paths_map.end())
-        {
-            return 0;
-        }
-        else
-        {
-            return pathIter->second.size();
-        }
-    }
+    return numPathsForKey(pimpl_->kmer_coder.encode(kmer));
 }
 
 std::vector<Path> KmerIndex::getPaths(const std::string& kmer) const
 {
-    const auto kmer_key = pimpl_->kmer_coder.encode(kmer);
-    const auto miniPathIter(pimpl_->kmer_to_minipaths_map.find(kmer_key));
-    if (miniPathIter != pimpl_->kmer_to_minipaths_map.end())
-    {
-        return { pimpl_->MiniPathToPath(miniPathIter->second) };
-    }
-    else
+    return getPathsForKey(pimpl_->kmer_coder.encode(kmer));
+}
+
+bool KmerIndex::containsKey(KmerKey_t kmer_key) const { return pimpl_->findKmer(kmer_key) != nullptr; }
+
+size_t KmerIndex::numPathsForKey(KmerKey_t kmer_key) const
+{
+    const KmerSlot* slot = pimpl_->findKmer(kmer_key);
+    return slot ? pimpl_->numPaths(*slot) : 0;
+}
+
+std::vector<Path> KmerIndex::getPathsForKey(KmerKey_t kmer_key) const
+{
+    const KmerSlot* slot = pimpl_->findKmer(kmer_key);
+    if (!slot)
     {
-        return pimpl_->kmer_to_paths_map.at(kmer_key);
+        throw std::out_of_range("Kmer " + pimpl_->kmer_coder.decode(kmer_key) + " is not in the index");
     }
+    return pimpl_->getPaths(*slot);
 }
 
 unordered_set<string> KmerIndex::kmers() const
 {
     unordered_set<string> kmers;
-    for (const auto& kv : pimpl_->kmer_to_minipaths_map)
+    for (const KmerSlot& slot : pimpl_->kmer_table)
     {
-        kmers.insert(pimpl_->kmer_coder.decode(kv.first));
+        if (!slot.isEmpty())
+        {
+            kmers.insert(pimpl_->kmer_coder.decode(slot.key));
+        }
     }
-    for (const auto& kv : pimpl_->kmer_to_paths_map)
+    return kmers;
+}
+
+void KmerIndex::numPathsForKmers(const TwoBitEncodedKmers& kmers, vector<uint32_t>& num_paths) const
+{
+    // Probes hit effectively random table slots, so the slot of a kmer further down the sequence is requested from
+    // memory while the current one is looked up
+    const size_t kPrefetchDistance = 8;
+    const size_t num_kmers = kmers.numKmers();
+    num_paths.assign(num_kmers, 0);
+
+    for (size_t kmer_start = 0; kmer_start != num_kmers; ++kmer_start)
     {
-        kmers.insert(pimpl_->kmer_coder.decode(kv.first));
+#if defined(__GNUC__)
+        const size_t prefetch_start = kmer_start + kPrefetchDistance;
+        if (prefetch_start < num_kmers && kmers.isValid(prefetch_start))
+        {
+            __builtin_prefetch(&pimpl_->kmer_table[pimpl_->homeSlot(kmers.forwardKey(prefetch_start))]);
+        }
+#endif
+        if (kmers.isValid(kmer_start))
+        {
+            const KmerSlot* slot = pimpl_->findKmer(kmers.forwardKey(kmer_start));
+            if (slot)
+            {
+                num_paths[kmer_start] = static_cast<uint32_t>(pimpl_->numPaths(*slot));
+            }
+        }
     }
-    return kmers;
 }
 
 size_t KmerIndex::numUniqueKmersOverlappingNode(NodeId node_id) const
@@ -21,39 +21,24 @@
 
 #include "graphalign/KmerIndexOperations.hh"
 
-#include <list>
+#include "graphutils/KmerEncoding.hh"
 
-#include <boost/algorithm/string.hpp>
-
-#include "graphutils/SequenceOperations.hh"
-
-using std::list;
 using std::string;
 
 namespace graphtools
 {
-list<string> extractKmersFromAllPositions(const string& sequence, int32_t kmer_len)
-{
-    list<string> kmers;
-    for (size_t pos = 0; pos + kmer_len <= sequence.length(); ++pos)
-    {
-        string kmer = sequence.substr(pos, static_cast<std::size_t>(kmer_len));
-        boost::to_upper(kmer);
-        kmers.push_back(kmer);
-    }
-    return kmers;
-}
-
-int32_t countKmerMatches(const KmerIndex& kmer_index, const std::string& seq)
+static int32_t countKmerMatches(const KmerIndex& kmer_index, const TwoBitEncodedKmers& kmers, bool use_reverse_complement)
 {
-    const list<string> kmers = extractKmersFromAllPositions(seq, kmer_index.kmerLength());
     int32_t num_kmer_matches = 0;
-
-    for (const string& kmer : kmers)
+    for (size_t pos = 0; pos != kmers.numKmers(); ++pos)
     {
-        if (kmer_index.numPaths(kmer) != 0)
+        if (kmers.isValid(pos))
         {
-            ++num_kmer_matches;
+            const auto kmer_key = use_reverse_complement ? kmers.reverseComplementKey(pos) : kmers.forwardKey(pos);
+            if (kmer_index.containsKey(kmer_key))
+            {
+                ++num_kmer_matches;
+            }
         }
     }
     return num_kmer_matches;
@@ -61,8 +46,10 @@ int32_t countKmerMatches(const KmerIndex& kmer_index, const std::string& seq)
 
 bool checkIfForwardOriented(const KmerIndex& kmer_index, const std::string& sequence)
 {
-    const int32_t num_forward_matches = countKmerMatches(kmer_index, sequence);
-    const int32_t num_revcomp_matches = countKmerMatches(kmer_index, reverseComplement(sequence));
+    TwoBitEncodedKmers kmers(kmer_index.kmerLength());
+    kmers.encode(sequence);
+    const int32_t num_forward_matches = countKmerMatches(kmer_index, kmers, false);
+    const int32_t num_revcomp_matches = countKmerMatches(kmer_index, kmers, true);
     return num_forward_matches >= num_revcomp_matches;
 }
 
@@ -30,7 +30,6 @@
 #include "graphalign/OperationOperations.hh"
 #include "graphutils/BaseMatching.hh"
 
-using std::list;
 using std::logic_error;
 using std::map;
 using std::string;
@@ -146,7 +145,7 @@ Alignment Alignment::splitAtReferencePosition(size_t reference_position)
 
     size_t first_unused_position = reference_start_;
 
-    list<Operation>::const_iterator operation_it = operations_.begin();
+    auto operation_it = operations_.begin();
 
     while (operation_it != operations_.end())
     {
@@ -170,26 +169,27 @@ Alignment Alignment::splitAtReferencePosition(size_t reference_position)
 
     if (first_unused_position == reference_position)
     {
-        list<Operation> suffix_operations;
-        suffix_operations.splice(suffix_operations.begin(), operations_, operation_it, operations_.end());
+        Operations suffix_operations(operation_it, operations_.end());
+        operations_.erase(operation_it, operations_.end());
 
         updateCounts();
-        return Alignment(first_unused_position, suffix_operations);
+        return Alignment(first_unused_position, std::move(suffix_operations));
     }
     else
     {
         const size_t first_piece_reference_length = reference_position - first_unused_position;
         OperationPair prefix_suffix = splitByReferenceLength(*operation_it, first_piece_reference_length);
 
-        list<Operation> suffix_operations;
-        suffix_operations.splice(suffix_operations.begin(), operations_, ++operation_it, operations_.end());
-        suffix_operations.push_front(prefix_suffix.second);
+        Operations suffix_operations;
+        suffix_operations.reserve(operations_.end() - operation_it);
+        suffix_operations.push_back(prefix_suffix.second);
+        suffix_operations.insert(suffix_operations.end(), operation_it + 1, operations_.end());
 
-        operations_.pop_back();
+        operations_.erase(operation_it, operations_.end());
         operations_.push_back(prefix_suffix.first);
 
         updateCounts();
-        return Alignment(reference_position, suffix_operations);
+        return Alignment(reference_position, std::move(suffix_operations));
     }
 }
 
@@ -122,26 +122,22 @@ Alignment mergeAlignments(const Alignment& first_alignment, const Alignment& sec
         throw std::logic_error(msg.str());
     }
 
-    list<Operation> first_alignment_operations = first_alignment.operations();
-    list<Operation> second_alignment_operations = second_alignment.operations();
+    const Alignment::Operations& second_alignment_operations = second_alignment.operations();
+    Alignment::Operations merged_operations;
+    merged_operations.reserve(first_alignment.numOperations() + second_alignment.numOperations());
+    merged_operations.assign(first_alignment.begin(), first_alignment.end());
 
-    if (first_alignment_operations.back().type() == second_alignment_operations.front().type())
+    auto second_alignment_operation_it = second_alignment_operations.begin();
+    if (merged_operations.back().type() == second_alignment_operation_it->type())
     {
-        const Operation last_operation_of_first_alignment = first_alignment_operations.back();
-        first_alignment_operations.pop_back();
-
-        const Operation first_operations_of_second_alignment = second_alignment_operations.front();
-        second_alignment_operations.pop_front();
-
-        uint32_t merged_operation_length
-            = last_operation_of_first_alignment.length() + first_operations_of_second_alignment.length();
-
-        first_alignment_operations.emplace_back(last_operation_of_first_alignment.type(), merged_operation_length);
+        uint32_t merged_operation_length = merged_operations.back().length() + second_alignment_operation_it->length();
+        merged_operations.back() = Operation(merged_operations.back().type(), merged_operation_length);
+        ++second_alignment_operation_it;
     }
 
-    first_alignment_operations.splice(first_alignment_operations.end(), second_alignment_operations);
+    merged_operations.insert(merged_operations.end(), second_alignment_operation_it, second_alignment_operations.end());
 
-    return Alignment(first_alignment.referenceStart(), first_alignment_operations);
+    return Alignment(first_alignment.referenceStart(), std::move(merged_operations));
 }
 
 int32_t scoreAlignment(const Alignment& alignment, int32_t match_score, int32_t mismatch_score, int32_t gap_score)
@@ -35,12 +35,19 @@ using std::to_string;
 namespace graphtools
 {
 
+const uint32_t Operation::kMaxLength;
+
+void Operation::throwLengthError(uint32_t length)
+{
+    throw logic_error("Operation length " + to_string(length) + " exceeds the maximum of " + to_string(kMaxLength));
+}
+
 string Operation::generateCigar() const
 {
-    string cigar_string = to_string(length_);
+    string cigar_string = to_string(length());
 
     std::ostringstream os;
-    os << type_;
+    os << type();
     cigar_string += os.str();
 
     return cigar_string;
@@ -68,21 +75,20 @@ OperationType decodeOperationType(char type_encoding)
 }
 
 Operation::Operation(string cigar)
+    : Operation(
+          decodeOperationType(cigar.back()), static_cast<uint32_t>(std::stoi(cigar.substr(0, cigar.length() - 1))))
 {
-    type_ = decodeOperationType(cigar.back());
-    cigar.pop_back();
-    length_ = std::stoi(cigar);
 }
 
 uint32_t Operation::referenceLength() const
 {
-    switch (type_)
+    switch (type())
     {
     case OperationType::kMatch:
     case OperationType::kMismatch:
     case OperationType::kMissingBases:
     case OperationType::kDeletionFromRef:
-        return length_;
+        return length();
     default:
         return 0;
     }
@@ -90,14 +96,14 @@ uint32_t Operation::referenceLength() const
 
 uint32_t Operation::queryLength() const
 {
-    switch (type_)
+    switch (type())
     {
     case OperationType::kMatch:
     case OperationType::kMismatch:
     case OperationType::kMissingBases:
     case OperationType::kInsertionToRef:
     case OperationType::kSoftclip:
-        return length_;
+        return length();
     default:
         return 0;
     }
@@ -105,12 +111,12 @@ uint32_t Operation::queryLength() const
 
 bool Operation::operator<(const Operation& other) const
 {
-    if (type_ != other.type_)
+    if (type() != other.type())
     {
-        return type_ < other.type_;
+        return type() < other.type();
     }
 
-    return length_ < other.length_;
+    return length() < other.length();
 }
 
 std::ostream& operator<<(std::ostream& os, OperationType operation_type)
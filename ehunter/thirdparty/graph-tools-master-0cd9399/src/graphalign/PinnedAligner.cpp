@@ -105,14 +105,62 @@ void PinnedAligner::fillBodyCell(TracebackMatrix& matrix, size_t row_index, size
     }
 }
 
-Alignment PinnedAligner::prefixAlign(const string& reference, const string& query)
+void PinnedAligner::locateTopScoringCell(
+    const string& reference, const string& query, size_t& top_row_index, size_t& top_col_index)
 {
-    TracebackMatrix matrix = populateTracebackMatrix(reference, query);
+    const size_t num_cols = reference.length() + 1;
+    row_scores_.resize(num_cols);
+
+    int32_t top_score = INT32_MIN;
+    auto update_top_scoring_cell = [&](int32_t score, size_t row_index, size_t col_index) {
+        if (top_score <= score)
+        {
+            top_score = score;
+            top_row_index = row_index;
+            top_col_index = col_index;
+        }
+    };
+
+    for (size_t col_index = 0; col_index != num_cols; ++col_index)
+    {
+        row_scores_[col_index] = static_cast<int32_t>(col_index) * gap_score_;
+        update_top_scoring_cell(row_scores_[col_index], 0, col_index);
+    }
+
+    for (size_t row_index = 1; row_index != query.length() + 1; ++row_index)
+    {
+        int32_t diagonal_score = row_scores_[0];
+        row_scores_[0] = static_cast<int32_t>(row_index) * gap_score_;
+        update_top_scoring_cell(row_scores_[0], row_index, 0);
+
+        for (size_t col_index = 1; col_index != num_cols; ++col_index)
+        {
+            const bool do_bases_match
+                = checkIfReferenceBaseMatchesQueryBase(reference[col_index - 1], query[row_index - 1]);
+            const int32_t top_score_in_col = row_scores_[col_index];
 
+            int32_t score = diagonal_score + (do_bases_match ? match_score_ : mismatch_score_);
+            score = std::max(score, row_scores_[col_index - 1] + gap_score_);
+            score = std::max(score, top_score_in_col + gap_score_);
+
+            diagonal_score = top_score_in_col;
+            row_scores_[col_index] = score;
+            update_top_scoring_cell(score, row_index, col_index);
+        }
+    }
+}
+
+Alignment PinnedAligner::prefixAlign(const string& reference, const string& query)
+{
     size_t top_row_index, top_col_index;
-    matrix.locateTopScoringCell(top_row_index, top_col_index);
+    locateTopScoringCell(reference, query, top_row_index, top_col_index);
+
+    // Traceback never leaves the part of the matrix above and to the left of the top-scoring cell, so only that part
+    // is populated; the rest of the query is softclipped by the runner
+    TracebackMatrix matrix
+        = populateTracebackMatrix(reference.substr(0, top_col_index), query.substr(0, top_row_index));
 
-    TracebackRunner traceback_runner(matrix);
+    TracebackRunner traceback_runner(matrix, query.length());
     Alignment alignment = traceback_runner.runTraceback(top_row_index, top_col_index);
 
     return alignment;
@@ -0,0 +1,258 @@
+//
+// GraphTools library
+// Copyright 2017-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#include "graphalign/PinnedPathAligner.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "graphutils/BaseMatching.hh"
+
+using std::list;
+using std::string;
+using std::vector;
+
+namespace graphtools
+{
+
+list<PathAndAlignment> PinnedPathAligner::suffixAlign(
+    const Path& seed_path, const string& query_piece, size_t extension_len, int& top_alignment_score) const
+{
+    const list<Path> top_paths
+        = findTopScoringExtensions(seed_path, query_piece, extension_len, true, top_alignment_score);
+
+    list<PathAndAlignment> top_paths_and_alignments;
+    for (const auto& path : top_paths)
+    {
+        Alignment alignment = pinnedAligner_.suffixAlign(path.seq(), query_piece);
+        assert(scoreAlignment(alignment) == top_alignment_score);
+        top_paths_and_alignments.emplace_back(path, std::move(alignment));
+    }
+
+    return top_paths_and_alignments;
+}
+
+list<PathAndAlignment> PinnedPathAligner::prefixAlign(
+    const Path& seed_path, const string& query_piece, size_t extension_len, int& top_alignment_score) const
+{
+    const list<Path> top_paths
+        = findTopScoringExtensions(seed_path, query_piece, extension_len, false, top_alignment_score);
+
+    list<PathAndAlignment> top_paths_and_alignments;
+    for (const auto& path : top_paths)
+    {
+        Alignment alignment = pinnedAligner_.prefixAlign(path.seq(), query_piece);
+        assert(scoreAlignment(alignment) == top_alignment_score);
+        top_paths_and_alignments.emplace_back(path, std::move(alignment));
+    }
+
+    return top_paths_and_alignments;
+}
+
+list<Path> PinnedPathAligner::findTopScoringExtensions(
+    const Path& seed_path, const string& query_piece, size_t extension_len, bool extend_start,
+    int32_t& top_score) const
+{
+    // Suffix alignment is a prefix alignment of the reversed sequences, so extensions of the path start are explored
+    // right-to-left against the reversed query
+    string seed_seq = seed_path.seq();
+    if (extend_start)
+    {
+        std::reverse(seed_seq.begin(), seed_seq.end());
+        initializeColumn(string(query_piece.rbegin(), query_piece.rend()));
+    }
+    else
+    {
+        initializeColumn(query_piece);
+    }
+
+    int32_t path_top_score = *std::max_element(columns_[0].begin(), columns_[0].end());
+    size_t column_index = 0;
+    for (char reference_base : seed_seq)
+    {
+        advanceColumn(0, reference_base, ++column_index, path_top_score);
+    }
+
+    ExtensionSearch search = { extend_start, INT32_MIN, {} };
+    searchExtensions(search, seed_path, static_cast<int32_t>(extension_len), 0, column_index, path_top_score);
+
+    top_score = search.top_score;
+    return std::move(search.top_paths);
+}
+
+void PinnedPathAligner::searchExtensions(
+    ExtensionSearch& search, const Path& path, int32_t extension_len, size_t depth, size_t column_index,
+    int32_t path_top_score) const
+{
+    if (!checkIfScoreIsReachable(depth, extension_len, path_top_score, search.top_score))
+    {
+        return;
+    }
+
+    const Graph& graph = *path.graphRawPtr();
+    const NodeId node_id = search.extend_start ? path.firstNodeId() : path.lastNodeId();
+    const string& node_seq = graph.nodeSeq(node_id);
+    const int32_t max_extension_on_node = search.extend_start
+        ? path.startPosition()
+        : static_cast<int32_t>(node_seq.length()) - path.endPosition();
+
+    const int32_t num_bases_on_node = std::min(extension_len, max_extension_on_node);
+    for (int32_t offset = 0; offset != num_bases_on_node; ++offset)
+    {
+        const char reference_base = search.extend_start ? node_seq[path.startPosition() - offset - 1]
+                                                        : node_seq[path.endPosition() + offset];
+        advanceColumn(depth, reference_base, ++column_index, path_top_score);
+    }
+
+    if (extension_len <= max_extension_on_node)
+    {
+        Path extended_path(path);
+        if (search.extend_start)
+        {
+            extended_path.shiftStartAlongNode(extension_len);
+        }
+        else
+        {
+            extended_path.shiftEndAlongNode(extension_len);
+        }
+
+        if (search.top_score < path_top_score)
+        {
+            search.top_paths.clear();
+            search.top_score = path_top_score;
+        }
+
+        if (search.top_score == path_top_score)
+        {
+            search.top_paths.push_back(std::move(extended_path));
+        }
+
+        return;
+    }
+
+    if (columns_.size() == depth + 1)
+    {
+        columns_.emplace_back();
+    }
+
+    const int32_t leftover_len = extension_len - max_extension_on_node;
+    const auto& next_node_ids = search.extend_start ? graph.predecessors(node_id) : graph.successors(node_id);
+    for (NodeId next_node_id : next_node_ids)
+    {
+        Path path_with_this_node(path);
+        if (search.extend_start)
+        {
+            path_with_this_node.extendStartToNode(next_node_id);
+        }
+        else
+        {
+            path_with_this_node.extendEndToNode(next_node_id);
+        }
+
+        columns_[depth + 1] = columns_[depth];
+        searchExtensions(search, path_with_this_node, leftover_len, depth + 1, column_index, path_top_score);
+    }
+}
+
+void PinnedPathAligner::initializeColumn(const string& query) const
+{
+    numRows_ = query.length() + 1;
+
+    queryProfile_.resize((codes::kMaxReferenceBaseCode + 1) * numRows_);
+    for (int reference_code = 0; reference_code <= codes::kMaxReferenceBaseCode; ++reference_code)
+    {
+        int32_t* substitution_scores = &queryProfile_[reference_code * numRows_];
+        substitution_scores[0] = 0;
+        for (size_t row_index = 1; row_index != numRows_; ++row_index)
+        {
+            const bool do_bases_match = checkIfReferenceBaseCodeMatchesQueryBaseCode(
+                static_cast<codes::BaseCode>(reference_code), encodeQueryBase(query[row_index - 1]));
+            substitution_scores[row_index] = do_bases_match ? matchScore_ : mismatchScore_;
+        }
+    }
+
+    if (columns_.empty())
+    {
+        columns_.emplace_back();
+    }
+
+    vector<int32_t>& column = columns_[0];
+    column.resize(numRows_);
+    for (size_t row_index = 0; row_index != numRows_; ++row_index)
+    {
+        column[row_index] = static_cast<int32_t>(row_index) * gapOpenScore_;
+    }
+}
+
+void PinnedPathAligner::advanceColumn(size_t depth, char reference_base, size_t column_index, int32_t& top_score) const
+{
+    vector<int32_t>& column = columns_[depth];
+    nextColumn_.resize(numRows_);
+
+    const int32_t* substitution_scores = &queryProfile_[encodeReferenceBase(reference_base) * numRows_];
+    const int32_t* previous = column.data();
+    int32_t* current = nextColumn_.data();
+
+    // Diagonal and horizontal moves only depend on the previous column, so this loop has no carried dependency and
+    // is vectorized by the compiler
+    current[0] = static_cast<int32_t>(column_index) * gapOpenScore_;
+    for (size_t row_index = 1; row_index != numRows_; ++row_index)
+    {
+        current[row_index]
+            = std::max(previous[row_index - 1] + substitution_scores[row_index], previous[row_index] + gapOpenScore_);
+    }
+
+    int32_t column_top_score = current[0];
+    for (size_t row_index = 1; row_index != numRows_; ++row_index)
+    {
+        current[row_index] = std::max(current[row_index], current[row_index - 1] + gapOpenScore_);
+        column_top_score = std::max(column_top_score, current[row_index]);
+    }
+
+    top_score = std::max(top_score, column_top_score);
+    column.swap(nextColumn_);
+}
+
+bool PinnedPathAligner::checkIfScoreIsReachable(
+    size_t depth, int32_t extension_len, int32_t path_top_score, int32_t score) const
+{
+    if (path_top_score >= score || gapOpenScore_ > 0)
+    {
+        return true;
+    }
+
+    // Any cell in the remaining columns is reached through some cell of the current column followed by at most
+    // min(extension_len, number of rows below) diagonal moves; gaps never increase the score
+    const int32_t max_gain_per_move = std::max(std::max(matchScore_, mismatchScore_), 0);
+    const vector<int32_t>& column = columns_[depth];
+    for (size_t row_index = 0; row_index != numRows_; ++row_index)
+    {
+        const auto num_rows_below = static_cast<int32_t>(numRows_ - row_index - 1);
+        const int32_t max_num_moves = std::min(extension_len, num_rows_below);
+        if (column[row_index] + max_gain_per_move * max_num_moves >= score)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+}
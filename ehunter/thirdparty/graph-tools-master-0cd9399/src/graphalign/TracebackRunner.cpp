@@ -35,7 +35,7 @@ Alignment TracebackRunner::runTraceback(size_t row_index, size_t col_index)
 {
     operations_.clear();
 
-    if (row_index != matrix_.numRows() - 1)
+    if (row_index != query_len_)
     {
         softclipQuerySuffix(row_index);
     }
@@ -124,7 +124,7 @@ void TracebackRunner::convertCurrentRunToAlignmentOperation()
 void TracebackRunner::softclipQuerySuffix(size_t& row_index)
 {
 
-    const uint32_t softclip_len = matrix_.numRows() - row_index - 1;
+    const uint32_t softclip_len = query_len_ - row_index;
 
     operations_.emplace_back(OperationType::kSoftclip, softclip_len);
 }
@@ -20,8 +20,67 @@
 
 #include "graphutils/KmerEncoding.hh"
 
+#include <algorithm>
+#include <cctype>
+
 namespace graphtools
 {
 
 TwoBitKmerEncoder::BaseToIndex TwoBitKmerEncoder::baseToIndex_;
+
+RollingTwoBitKmerEncoder::BaseToCode RollingTwoBitKmerEncoder::baseToCode_;
+
+const uint8_t RollingTwoBitKmerEncoder::kInvalidBaseCode;
+
+RollingTwoBitKmerEncoder::BaseToCode::BaseToCode()
+{
+    std::fill(table, table + 256, kInvalidBaseCode);
+    const std::string bases = "ACGT";
+    for (uint8_t code = 0; code != bases.size(); ++code)
+    {
+        table[static_cast<uint8_t>(bases[code])] = code;
+        table[static_cast<uint8_t>(std::tolower(bases[code]))] = code;
+    }
+}
+
+RollingTwoBitKmerEncoder::RollingTwoBitKmerEncoder(size_t kmerLength)
+    : kmerLength_(kmerLength)
+{
+    const size_t maxKeyBitCount(8 * sizeof(KmerKey_t));
+    if (kmerLength_ == 0 or maxKeyBitCount < (kmerLength_ * 2))
+    {
+        throw std::logic_error("Can't encode kmers of size " + std::to_string(kmerLength_));
+    }
+
+    keyMask_ = kmerLength_ * 2 == maxKeyBitCount ? ~static_cast<KmerKey_t>(0)
+                                                 : (static_cast<KmerKey_t>(1) << (2 * kmerLength_)) - 1;
+    reverseShift_ = static_cast<unsigned>(2 * (kmerLength_ - 1));
+}
+
+TwoBitEncodedKmers::TwoBitEncodedKmers(size_t kmerLength)
+    : encoder_(kmerLength)
+{
+}
+
+void TwoBitEncodedKmers::encode(const std::string& sequence)
+{
+    const size_t kmerLength = encoder_.kmerLength();
+    const size_t numKmers = sequence.length() < kmerLength ? 0 : sequence.length() - kmerLength + 1;
+    forwardKeys_.resize(numKmers);
+    reverseComplementKeys_.resize(numKmers);
+    isValid_.resize(numKmers);
+
+    encoder_.reset();
+    for (size_t position = 0; position != sequence.length(); ++position)
+    {
+        const bool isValidKmer = encoder_.addBase(sequence[position]);
+        if (position + 1 >= kmerLength)
+        {
+            const size_t kmerStart = position + 1 - kmerLength;
+            forwardKeys_[kmerStart] = encoder_.forwardKey();
+            reverseComplementKeys_[kmerStart] = encoder_.reverseComplementKey();
+            isValid_[kmerStart] = isValidKmer;
+        }
+    }
+}
 }
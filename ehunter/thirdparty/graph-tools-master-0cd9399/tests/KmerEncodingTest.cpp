@@ -34,3 +34,38 @@ TEST(TwoBitKmerEncoder, 1TwoBitKmerEncoder)
     ASSERT_EQ(ke.encode(ke.decode(12)), 12);
     ASSERT_EQ(ke.encode(ke.decode(0)), 0);
 }
+
+TEST(TwoBitEncodedKmers, TypicalSequence_KmersOnBothStrandsEncoded)
+{
+    TwoBitKmerEncoder ke(3);
+    TwoBitEncodedKmers kmers(3);
+    kmers.encode("AcGTTa");
+
+    ASSERT_EQ(4u, kmers.numKmers());
+    EXPECT_EQ(ke.encode("ACG"), kmers.forwardKey(0));
+    EXPECT_EQ(ke.encode("CGT"), kmers.reverseComplementKey(0));
+    EXPECT_EQ(ke.encode("TTA"), kmers.forwardKey(3));
+    EXPECT_EQ(ke.encode("TAA"), kmers.reverseComplementKey(3));
+    for (size_t pos = 0; pos != kmers.numKmers(); ++pos)
+    {
+        EXPECT_TRUE(kmers.isValid(pos));
+    }
+}
+
+TEST(TwoBitEncodedKmers, SequenceWithNonNucleotideSymbols_OverlappingKmersInvalid)
+{
+    TwoBitKmerEncoder ke(2);
+    TwoBitEncodedKmers kmers(2);
+    kmers.encode("ACNGTA");
+
+    ASSERT_EQ(5u, kmers.numKmers());
+    EXPECT_TRUE(kmers.isValid(0));
+    EXPECT_FALSE(kmers.isValid(1));
+    EXPECT_FALSE(kmers.isValid(2));
+    EXPECT_TRUE(kmers.isValid(3));
+    EXPECT_EQ(ke.encode("GT"), kmers.forwardKey(3));
+    EXPECT_EQ(ke.encode("TA"), kmers.reverseComplementKey(4));
+
+    kmers.encode("A");
+    EXPECT_EQ(0u, kmers.numKmers());
+}
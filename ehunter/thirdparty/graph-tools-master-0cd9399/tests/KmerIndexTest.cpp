@@ -27,10 +27,12 @@
 
 #include "graphcore/GraphBuilders.hh"
 #include "graphcore/Path.hh"
+#include "graphutils/KmerEncoding.hh"
 
 using std::list;
 using std::string;
 using std::unordered_set;
+using std::vector;
 
 using namespace graphtools;
 
@@ -127,6 +129,48 @@ TEST(CountingNumberOfPathsAssociatedWithKmer, TypicalKmers_PathCountObtained)
     }
 }
 
+TEST(LookingUpEncodedKmers, TypicalKmers_SameResultsAsStringLookups)
+{
+    Graph graph = makeDoubleSwapGraph("AAA", "TTT", "CCC", "AAA", "TTT", "AAA", "TTT");
+    const int32_t kmer_size = 6;
+    KmerIndex kmer_index(graph, kmer_size);
+    TwoBitKmerEncoder kmer_encoder(kmer_size);
+
+    for (const string kmer : { "AAATTT", "TTTTTT", "AAATTG", "CCCCCC" })
+    {
+        const auto kmer_key = kmer_encoder.encode(kmer);
+        EXPECT_EQ(kmer_index.contains(kmer), kmer_index.containsKey(kmer_key));
+        EXPECT_EQ(kmer_index.numPaths(kmer), kmer_index.numPathsForKey(kmer_key));
+    }
+
+    EXPECT_EQ(kmer_index.getPaths("AAATTT"), kmer_index.getPathsForKey(kmer_encoder.encode("AAATTT")));
+    EXPECT_THROW(kmer_index.getPathsForKey(kmer_encoder.encode("AAATTG")), std::out_of_range);
+}
+
+TEST(LookingUpEncodedKmers, TypicalSequence_BatchLookupMatchesPerKmerLookups)
+{
+    Graph graph = makeDoubleSwapGraph("AAA", "TTT", "CCC", "AAA", "TTT", "AAA", "TTT");
+    const int32_t kmer_size = 6;
+    KmerIndex kmer_index(graph, kmer_size);
+
+    const string query = "GAAATTTTTTAAAcccAAATTTNAAATTTTTTCCCAAATTT";
+    TwoBitEncodedKmers query_kmers(kmer_size);
+    query_kmers.encode(query);
+
+    vector<uint32_t> num_paths;
+    kmer_index.numPathsForKmers(query_kmers, num_paths);
+
+    ASSERT_EQ(query.length() - kmer_size + 1, num_paths.size());
+    for (size_t kmer_start = 0; kmer_start != num_paths.size(); ++kmer_start)
+    {
+        const size_t expected_num_paths = query_kmers.isValid(kmer_start)
+            ? kmer_index.numPathsForKey(query_kmers.forwardKey(kmer_start))
+            : 0;
+        EXPECT_EQ(expected_num_paths, num_paths[kmer_start]) << "kmer starting at " << kmer_start;
+    }
+    EXPECT_EQ(0u, num_paths[query.find('N')]);
+}
+
 TEST(UniqueKmerCounting, TypicalIndex_UniqueKmersCounted)
 {
     Graph graph = makeDeletionGraph("AC", "GG", "ACG");
@@ -22,15 +22,15 @@
 
 #include "gtest/gtest.h"
 
-using std::list;
 using std::string;
+using std::vector;
 
 using namespace graphtools;
 
 TEST(AlignmentInitialization, TypicalCigarString_AlignmentCreated)
 {
     Alignment alignment(3u, "3M1X2N2D2M3I1M10S");
-    const list<Operation> operations = { Operation("3M"), Operation("1X"), Operation("2N"), Operation("2D"),
+    const vector<Operation> operations = { Operation("3M"), Operation("1X"), Operation("2N"), Operation("2D"),
                                          Operation("2M"), Operation("3I"), Operation("1M"), Operation("10S") };
 
     Alignment expected_alignment(3u, operations);
@@ -22,7 +22,10 @@
 
 #include "gtest/gtest.h"
 
+#include "graphalign/TracebackRunner.hh"
+
 using std::string;
+using std::vector;
 
 using namespace graphtools;
 
@@ -100,3 +103,22 @@ TEST(PerformingSuffixAlignment, NoBasesAlign_SoftclipAlignment)
     Alignment expected_alignment(8, "6S");
     EXPECT_EQ(expected_alignment, alignment);
 }
+
+TEST(PerformingPrefixAlignment, TypicalSequences_AlignmentMatchesFullMatrixTraceback)
+{
+    const string reference = "TTGCCGCCGCCGCCGCTGCCGAGGANCC";
+    const vector<string> queries
+        = { "TTGCCGCCGCCGCCGCCGCCGCCG", "TTGCCGCAGCCGCCGCTGCCAAAAAA", "AAAAAAAAAA", "GCCGCC", "TTGCCGCCGCC", "T" };
+
+    PinnedAligner aligner(5, -4, -8);
+    for (const string& query : queries)
+    {
+        TracebackMatrix matrix = aligner.populateTracebackMatrix(reference, query);
+        size_t top_row_index, top_col_index;
+        matrix.locateTopScoringCell(top_row_index, top_col_index);
+        TracebackRunner traceback_runner(matrix);
+        Alignment expected_alignment = traceback_runner.runTraceback(top_row_index, top_col_index);
+
+        EXPECT_EQ(expected_alignment, aligner.prefixAlign(reference, query));
+    }
+}
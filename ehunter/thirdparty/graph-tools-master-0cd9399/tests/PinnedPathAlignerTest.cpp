@@ -0,0 +1,126 @@
+//
+// GraphTools library
+// Copyright 2017-2019 Illumina, Inc.
+// All rights reserved.
+//
+// Author: Egor Dolzhenko <edolzhenko@illumina.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#include "graphalign/PinnedPathAligner.hh"
+
+#include "gtest/gtest.h"
+
+#include "graphcore/Graph.hh"
+#include "graphcore/GraphBuilders.hh"
+#include "graphcore/Path.hh"
+
+using std::list;
+using std::string;
+
+using namespace graphtools;
+
+// Aligns the query to every extension of the seed path separately
+static list<PathAndAlignment> alignToEachExtension(
+    const Path& seed_path, const string& query_piece, size_t extension_len, bool extend_start, int& top_score)
+{
+    PinnedAligner aligner(5, -4, -8);
+    list<PathAndAlignment> top_paths_and_alignments;
+    top_score = INT32_MIN;
+
+    const list<Path> extensions
+        = extend_start ? extendPathStart(seed_path, extension_len) : extendPathEnd(seed_path, extension_len);
+    for (const auto& path : extensions)
+    {
+        Alignment alignment = extend_start ? aligner.suffixAlign(path.seq(), query_piece)
+                                           : aligner.prefixAlign(path.seq(), query_piece);
+        const int score = scoreAlignment(alignment, 5, -4, -8);
+        if (top_score < score)
+        {
+            top_paths_and_alignments.clear();
+            top_score = score;
+        }
+        if (top_score == score)
+        {
+            top_paths_and_alignments.emplace_back(path, alignment);
+        }
+    }
+
+    return top_paths_and_alignments;
+}
+
+TEST(PerformingPathPrefixAlignment, QueryOverRepeat_TopExtensionsFound)
+{
+    Graph graph = makeStrGraph("ATA", "CG", "TATTTTTTTTT");
+    Path seed_path(&graph, 3, { 0 }, 3);
+    PinnedPathAligner aligner;
+
+    for (const string query : { "CGCGCGTA", "CCGCGTAT", "CGCGCGCGCGCGCG", "TATTTT", "GGGGGG", "" })
+    {
+        for (size_t extension_len : { 4, 8, 13 })
+        {
+            int score = 0;
+            int expected_score = 0;
+            const list<PathAndAlignment> paths_and_alignments
+                = aligner.prefixAlign(seed_path, query, extension_len, score);
+            const list<PathAndAlignment> expected_paths_and_alignments
+                = alignToEachExtension(seed_path, query, extension_len, false, expected_score);
+
+            EXPECT_EQ(expected_score, score);
+            EXPECT_EQ(expected_paths_and_alignments, paths_and_alignments);
+        }
+    }
+}
+
+TEST(PerformingPathSuffixAlignment, QueryOverRepeat_TopExtensionsFound)
+{
+    Graph graph = makeStrGraph("TTTTTTTTATA", "CG", "TAT");
+    Path seed_path(&graph, 0, { 2 }, 0);
+    PinnedPathAligner aligner;
+
+    for (const string query : { "ATACGCGCG", "TTATACGCCG", "CGCGCGCGCGCGCG", "TTTTAT", "GGGGGG", "" })
+    {
+        for (size_t extension_len : { 4, 8, 13 })
+        {
+            int score = 0;
+            int expected_score = 0;
+            const list<PathAndAlignment> paths_and_alignments
+                = aligner.suffixAlign(seed_path, query, extension_len, score);
+            const list<PathAndAlignment> expected_paths_and_alignments
+                = alignToEachExtension(seed_path, query, extension_len, true, expected_score);
+
+            EXPECT_EQ(expected_score, score);
+            EXPECT_EQ(expected_paths_and_alignments, paths_and_alignments);
+        }
+    }
+}
+
+TEST(PerformingPathPrefixAlignment, EquallyGoodBranches_AllBranchesReported)
+{
+    Graph graph = makeSwapGraph("AAAN", "CT", "GT", "TTTTT");
+    Path seed_path(&graph, 2, { 0 }, 2);
+    PinnedPathAligner aligner;
+
+    int score = 0;
+    const list<PathAndAlignment> paths_and_alignments = aligner.prefixAlign(seed_path, "AGATTT", 6, score);
+
+    int expected_score = 0;
+    const list<PathAndAlignment> expected_paths_and_alignments
+        = alignToEachExtension(seed_path, "AGATTT", 6, false, expected_score);
+
+    EXPECT_EQ(2ul, paths_and_alignments.size());
+    EXPECT_EQ(expected_score, score);
+    EXPECT_EQ(expected_paths_and_alignments, paths_and_alignments);
+}